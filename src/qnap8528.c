@@ -27,18 +27,31 @@
  *	      Fixed erroneous check for slot activity support when setting ERROR off
  */
 
+#include <linux/completion.h>
+#include <linux/debugfs.h>
 #include <linux/delay.h>
+#include <linux/dmi.h>
+#include <linux/firmware.h>
 #include <linux/hwmon.h>
 #include <linux/input.h>
 #include <linux/io.h>
 #include <linux/ioport.h>
+#include <linux/ktime.h>
 #include <linux/leds.h>
 #include <linux/module.h>
 #include <linux/mutex.h>
 #include <linux/platform_device.h>
+#include <linux/regmap.h>
+#include <linux/seq_file.h>
+#include <linux/slab.h>
+#include <linux/spinlock.h>
 #include <linux/time.h>
+#include <linux/workqueue.h>
 #include "qnap8528.h"
 
+#define CREATE_TRACE_POINTS
+#include "qnap8528_trace.h"
+
 static bool qnap8528_skip_hw_check;
 module_param_named(skip_hw_check, qnap8528_skip_hw_check, bool, 0);
 MODULE_PARM_DESC(skip_hw_check, "Skip HW check for IT8528 device");
@@ -51,7 +64,32 @@ static bool qnap8528_preserve_leds = true;
 module_param_named(preserve_leds, qnap8528_preserve_leds, bool, 0);
 MODULE_PARM_DESC(preserve_leds, "Preserve LED states on module unload (default on)");
 
-static DEFINE_MUTEX(qnap8528_ec_lock);
+static char *qnap8528_model;
+module_param_named(model, qnap8528_model, charp, 0);
+MODULE_PARM_DESC(model, "Use the configuration of this model (e.g. TS-473A) instead of detecting it");
+
+static unsigned int qnap8528_ec_spin_us;
+module_param_named(ec_spin_us, qnap8528_ec_spin_us, uint, 0644);
+MODULE_PARM_DESC(ec_spin_us, "Time in microseconds to busy-poll the EC status before sleeping between polls (default 0, calibrated at probe)");
+
+static unsigned int qnap8528_ec_sleep_ms;
+module_param_named(ec_sleep_ms, qnap8528_ec_sleep_ms, uint, 0644);
+MODULE_PARM_DESC(ec_sleep_ms, "Time in milliseconds to keep sleep-polling the EC status before giving up (default 0, per model)");
+
+static unsigned int qnap8528_ec_timeout_ms = QNAP8528_EC_TIMEOUT_MS;
+module_param_named(ec_timeout_ms, qnap8528_ec_timeout_ms, uint, 0644);
+MODULE_PARM_DESC(ec_timeout_ms, "Deadline in milliseconds for a single EC read or write, including all handshake stages (default 5000)");
+
+static unsigned int qnap8528_vpd_settle_us = QNAP8528_VPD_SETTLE_US;
+module_param_named(vpd_settle_us, qnap8528_vpd_settle_us, uint, 0644);
+MODULE_PARM_DESC(vpd_settle_us, "Maximum time in microseconds to wait for a VPD byte to settle after moving the address (default 5000)");
+
+static bool qnap8528_fan_enumerate_param;
+module_param_named(fan_enumerate, qnap8528_fan_enumerate_param, bool, 0);
+MODULE_PARM_DESC(fan_enumerate, "Detect the fans from the EC in the background after loading instead of using the model's fan list (default off)");
+
+static struct qnap8528_ec_queue qnap8528_ec_queue;
+static struct qnap8528_ec_stats qnap8528_ec_stats;
 
 static struct resource qnap8528_resources[] = {
 	DEFINE_RES_IO_NAMED(QNAP8528_EC_CMD_PORT, 1, DRVNAME),
@@ -64,12 +102,16 @@ static DEVICE_ATTR(fw_version, 0444, qnap8528_fw_version_attr_show, NULL);
 static DEVICE_ATTR(cpld_version, 0444, qnap8528_cpld_version_attr_show, NULL);
 static DEVICE_ATTR(power_recovery, 0644, qnap8528_power_recovery_attr_show, qnap8528_power_recovery_attr_store);
 static DEVICE_ATTR(eup_mode, 0644, qnap8528_eup_mode_attr_show, qnap8528_eup_mode_attr_store);
+static DEVICE_ATTR(breaker_state, 0444, qnap8528_breaker_state_attr_show, NULL);
+static DEVICE_ATTR(breaker_trips, 0444, qnap8528_breaker_trips_attr_show, NULL);
 
 static struct attribute *qnap8528_ec_attrs[] = {
 	&dev_attr_fw_version.attr,
 	&dev_attr_cpld_version.attr,
 	&dev_attr_power_recovery.attr,
 	&dev_attr_eup_mode.attr,
+	&dev_attr_breaker_state.attr,
+	&dev_attr_breaker_trips.attr,
 	NULL
 };
 
@@ -93,6 +135,9 @@ static QNAP8528_DEVICE_ATTR(backplane_name, 0444, qnap8528_vpd_attr_show, NULL,
 static QNAP8528_DEVICE_ATTR(backplane_model, 0444, qnap8528_vpd_attr_show, NULL, QNAP8528_VPD_BP_MODEL);
 static QNAP8528_DEVICE_ATTR(backplane_serial, 0444, qnap8528_vpd_attr_show, NULL, QNAP8528_VPD_BP_SERIAL);
 static QNAP8528_DEVICE_ATTR(backplane_date, 0444, qnap8528_vpd_attr_show, NULL, QNAP8528_VPD_BP_DATE);
+static QNAP8528_DEVICE_ATTR(refresh, 0200, NULL, qnap8528_vpd_refresh_store, 0);
+static QNAP8528_DEVICE_ATTR(query, 0644, qnap8528_vpd_query_show, qnap8528_vpd_query_store, 0);
+static QNAP8528_DEVICE_ATTR(all, 0444, qnap8528_vpd_all_show, NULL, 0);
 
 static struct attribute *qnap8528_vpd_attrs[] = {
 	&dev_attr_enclosure_serial.attr,
@@ -109,12 +154,53 @@ static struct attribute *qnap8528_vpd_attrs[] = {
 	&dev_attr_backplane_model.attr,
 	&dev_attr_backplane_serial.attr,
 	&dev_attr_backplane_date.attr,
+	&dev_attr_refresh.attr,
+	&dev_attr_query.attr,
+	&dev_attr_all.attr,
+	NULL
+};
+
+/* Raw VPD tables, .private holds the table number */
+static struct bin_attribute bin_attr_table0 = {
+	.attr = { .name = "table0", .mode = 0444 },
+	.size = QNAP8528_VPD_TABLE_SIZE,
+	.read = qnap8528_vpd_table_read,
+	.private = (void *)0,
+};
+
+static struct bin_attribute bin_attr_table1 = {
+	.attr = { .name = "table1", .mode = 0444 },
+	.size = QNAP8528_VPD_TABLE_SIZE,
+	.read = qnap8528_vpd_table_read,
+	.private = (void *)1,
+};
+
+static struct bin_attribute bin_attr_table2 = {
+	.attr = { .name = "table2", .mode = 0444 },
+	.size = QNAP8528_VPD_TABLE_SIZE,
+	.read = qnap8528_vpd_table_read,
+	.private = (void *)2,
+};
+
+static struct bin_attribute bin_attr_table3 = {
+	.attr = { .name = "table3", .mode = 0444 },
+	.size = QNAP8528_VPD_TABLE_SIZE,
+	.read = qnap8528_vpd_table_read,
+	.private = (void *)3,
+};
+
+static struct bin_attribute *qnap8528_vpd_bin_attrs[] = {
+	&bin_attr_table0,
+	&bin_attr_table1,
+	&bin_attr_table2,
+	&bin_attr_table3,
 	NULL
 };
 
 static const struct attribute_group qnap8528_vpd_attr_group = {
 	.name = "vpd",
-	.attrs = qnap8528_vpd_attrs
+	.attrs = qnap8528_vpd_attrs,
+	.bin_attrs = qnap8528_vpd_bin_attrs
 };
 
 static const struct attribute_group *qnap8528_pdriver_attr_groups[] = {
@@ -123,37 +209,25 @@ static const struct attribute_group *qnap8528_pdriver_attr_groups[] = {
 	NULL
 };
 
+/* Probed once from init through platform_driver_probe(), the model table is gone after that */
 static struct platform_driver qnap8528_pdriver = {
 	.driver = {
 		.name = DRVNAME,
 		.dev_groups = qnap8528_pdriver_attr_groups
 	},
-	.probe = qnap8528_probe
-};
-
-static u32 qnap8528_hwmon_temp_config[QNAP8528_HWMON_MAX_CHANNELS + 1] = {0};
-static struct hwmon_channel_info qnap8528_hwmon_temp_chan_info = {
-	.type = hwmon_temp,
-	.config = qnap8528_hwmon_temp_config
 };
 
-static u32 qnap8528_hwmon_fan_config[QNAP8528_HWMON_MAX_CHANNELS + 1] = {0};
-static struct hwmon_channel_info qnap8528_hwmon_fan_chan_info = {
-	.type = hwmon_fan,
-	.config = qnap8528_hwmon_fan_config
+static const struct qnap8528_fan_bank qnap8528_fan_banks[QNAP8528_HWMON_PWM_BANKS] = {
+	{ .first = 0x00, .count = 6, .status_reg = 0x242, .pwm_reg = 0x22e },
+	{ .first = 0x06, .count = 2, .status_reg = 0x244, .pwm_reg = 0x24b },
+	{ .first = 0x14, .count = 6, .status_reg = 0x259, .pwm_reg = 0x22f },
+	{ .first = 0x1e, .count = 6, .status_reg = 0x25a, .pwm_reg = 0x23b },
 };
 
-static u32 qnap8528_hwmon_pwm_config[QNAP8528_HWMON_MAX_CHANNELS + 1] = {0};
-static struct hwmon_channel_info qnap8528_hwmon_pwm_chan_info = {
-	.type = hwmon_pwm,
-	.config = qnap8528_hwmon_pwm_config
-};
-
-static const struct hwmon_channel_info *qnap8528_hwmon_chan_info[] = {
-	&qnap8528_hwmon_temp_chan_info,
-	&qnap8528_hwmon_fan_chan_info,
-	&qnap8528_hwmon_pwm_chan_info,
-	NULL
+static const u32 qnap8528_hwmon_chip_config[] = { HWMON_C_UPDATE_INTERVAL, 0 };
+static const struct hwmon_channel_info qnap8528_hwmon_chip_chan_info = {
+	.type = hwmon_chip,
+	.config = qnap8528_hwmon_chip_config
 };
 
 static const struct hwmon_ops qnap8528_hwmon_ops = {
@@ -162,9 +236,67 @@ static const struct hwmon_ops qnap8528_hwmon_ops = {
 	.write = qnap8528_hwmon_write
 };
 
-static struct hwmon_chip_info qnap8528_hwmon_chip_info = {
-	.ops = &qnap8528_hwmon_ops,
-	.info = qnap8528_hwmon_chan_info
+static const struct regmap_range qnap8528_regmap_rd_ranges[] = {
+	regmap_reg_range(QNAP8528_PWR_RECOVERY_REG, QNAP8528_PWR_RECOVERY_REG),
+	regmap_reg_range(QNAP8528_VPD_REG_FIRST, QNAP8528_VPD_REG_LAST),
+	regmap_reg_range(QNAP8528_EUP_SUPPORT_REG, QNAP8528_EUP_SUPPORT_REG),
+	regmap_reg_range(QNAP8528_EUP_MODE_REG, QNAP8528_EUP_MODE_REG),
+	regmap_reg_range(QNAP8528_BUTTON_INPUT_REG, QNAP8528_BUTTON_INPUT_REG),
+	regmap_reg_range(QNAP8528_FAN_REG_FIRST, QNAP8528_FAN_REG_LAST),
+	regmap_reg_range(QNAP8528_EC_FW_VER_REG, QNAP8528_EC_FW_VER_REG + QNAP8528_EC_FW_VER_LEN - 1),
+	regmap_reg_range(QNAP8528_CPLD_VER_REG, QNAP8528_CPLD_VER_REG),
+	regmap_reg_range(QNAP8528_SENSOR_REG_FIRST, QNAP8528_SENSOR_REG_LAST),
+};
+
+static const struct regmap_access_table qnap8528_regmap_rd_table = {
+	.yes_ranges = qnap8528_regmap_rd_ranges,
+	.n_yes_ranges = ARRAY_SIZE(qnap8528_regmap_rd_ranges),
+};
+
+/* Registers that never change at runtime, the VPD address is only moved by us */
+static const struct regmap_range qnap8528_regmap_static_ranges[] = {
+	regmap_reg_range(0x56, 0x57),
+	regmap_reg_range(0x59, 0x5a),
+	regmap_reg_range(0x5c, 0x5d),
+	regmap_reg_range(0x60, 0x61),
+	regmap_reg_range(QNAP8528_EUP_SUPPORT_REG, QNAP8528_EUP_SUPPORT_REG),
+	regmap_reg_range(QNAP8528_EC_FW_VER_REG, QNAP8528_EC_FW_VER_REG + QNAP8528_EC_FW_VER_LEN - 1),
+	regmap_reg_range(QNAP8528_CPLD_VER_REG, QNAP8528_CPLD_VER_REG),
+};
+
+static const struct regmap_access_table qnap8528_regmap_volatile_table = {
+	.no_ranges = qnap8528_regmap_static_ranges,
+	.n_no_ranges = ARRAY_SIZE(qnap8528_regmap_static_ranges),
+};
+
+static const struct regmap_range qnap8528_regmap_ro_ranges[] = {
+	regmap_reg_range(QNAP8528_EUP_SUPPORT_REG, QNAP8528_EUP_SUPPORT_REG),
+	regmap_reg_range(QNAP8528_BUTTON_INPUT_REG, QNAP8528_BUTTON_INPUT_REG),
+	regmap_reg_range(QNAP8528_EC_FW_VER_REG, QNAP8528_EC_FW_VER_REG + QNAP8528_EC_FW_VER_LEN - 1),
+	regmap_reg_range(QNAP8528_CPLD_VER_REG, QNAP8528_CPLD_VER_REG),
+	regmap_reg_range(QNAP8528_SENSOR_REG_FIRST, QNAP8528_SENSOR_REG_LAST),
+};
+
+static const struct regmap_access_table qnap8528_regmap_wr_table = {
+	.no_ranges = qnap8528_regmap_ro_ranges,
+	.n_no_ranges = ARRAY_SIZE(qnap8528_regmap_ro_ranges),
+};
+
+static const struct regmap_bus qnap8528_regmap_bus = {
+	.reg_read = qnap8528_regmap_reg_read,
+	.reg_write = qnap8528_regmap_reg_write,
+	.reg_update_bits = qnap8528_regmap_reg_update_bits,
+};
+
+static const struct regmap_config qnap8528_regmap_config = {
+	.name = "ec",
+	.reg_bits = 16,
+	.val_bits = 8,
+	.max_register = QNAP8528_EC_MAX_REG,
+	.rd_table = &qnap8528_regmap_rd_table,
+	.wr_table = &qnap8528_regmap_wr_table,
+	.volatile_table = &qnap8528_regmap_volatile_table,
+	.cache_type = REGCACHE_RBTREE,
 };
 
 static DEVICE_ATTR_WO(blink_bicolor);
@@ -195,45 +327,72 @@ static int qnap8528_ec_hw_check(void)
 	return ret;
 }
 
-static int qnap8528_ec_wait_ibf_clear(void)
+/*
+ * The EC usually answers within a few microseconds, so poll the status port
+ * tightly for a short while and only then back off to sleeping between polls,
+ * this keeps fast transactions fast without pinning a CPU on a slow EC.
+ */
+static int qnap8528_ec_wait_status(enum qnap8528_ec_stage stage, u8 mask, u8 value, bool drain)
 {
-	int retries = 0;
+	struct qnap8528_ec_stage_stats *stats = &qnap8528_ec_stats.stages[stage];
+	struct qnap8528_ec_xact *xact = &qnap8528_ec_queue.xact;
+	ktime_t now, begin, spin_end, sleep_end;
+	u64 retries = 0;
+
+	/* Module params override the model profile when set */
+	begin = ktime_get();
+	spin_end = ktime_add_us(begin, READ_ONCE(qnap8528_ec_spin_us) ?: READ_ONCE(qnap8528_ec_queue.timing.spin_us));
+	sleep_end = ktime_add_ms(spin_end, READ_ONCE(qnap8528_ec_sleep_ms) ?: READ_ONCE(qnap8528_ec_queue.timing.sleep_ms));
+	stats->calls++;
+
+	for (;;) {
+		if ((inb(QNAP8528_EC_CMD_PORT) & mask) == value)
+			break;
 
-	do {
-		if (!(inb(QNAP8528_EC_CMD_PORT) & BIT(1)))
-			return 0;
-		udelay(QNAP8528_EC_UDELAY);
-	} while (retries++ < QNAP8528_EC_MAX_RETRY);
-	return -EBUSY;
+		/* Drain stale data so the EC can set OBF again if it needs to */
+		if (drain)
+			inb(QNAP8528_EC_DAT_PORT);
+
+		now = ktime_get();
+		if (ktime_after(now, sleep_end) || ktime_after(now, xact->deadline)) {
+			stats->timeouts++;
+			trace_qnap8528_ec_timeout(xact->seq, xact->command, xact->data, stage, xact->retries,
+						  ktime_to_ns(ktime_sub(now, xact->start)));
+			return -EBUSY;
+		}
+
+		xact->retries++;
+		stats->retries++;
+		stats->max_retries = max(stats->max_retries, ++retries);
+
+		if (ktime_before(now, spin_end))
+			cpu_relax();
+		else
+			usleep_range(QNAP8528_EC_SLEEP_MIN_US, QNAP8528_EC_SLEEP_MAX_US);
+	}
+
+	xact->max_wait_ns = max_t(u64, xact->max_wait_ns, ktime_to_ns(ktime_sub(ktime_get(), begin)));
+	return 0;
 }
 
-static int qnap8528_ec_clear_obf(void)
+static int qnap8528_ec_wait_ibf_clear(void)
 {
-	int retries = 0;
+	return qnap8528_ec_wait_status(QNAP8528_EC_STAGE_IBF_CLEAR, QNAP8528_EC_STATUS_IBF, 0, false);
+}
 
-	do {
-		if (!(inb(QNAP8528_EC_CMD_PORT) & BIT(0)))
-			return 0;
-		inb(QNAP8528_EC_DAT_PORT);
-		udelay(QNAP8528_EC_UDELAY);
-	} while (retries++ < QNAP8528_EC_MAX_RETRY);
-	return -EBUSY;
+static int qnap8528_ec_clear_obf(void)
+{
+	return qnap8528_ec_wait_status(QNAP8528_EC_STAGE_OBF_CLEAR, QNAP8528_EC_STATUS_OBF, 0, true);
 }
 
 static int qnap8528_ec_wait_obf_set(void)
 {
-	int retries = 0;
-
-	do {
-		if (inb(QNAP8528_EC_CMD_PORT) & BIT(0))
-			return 0;
-		udelay(QNAP8528_EC_UDELAY);
-	} while (retries++ < QNAP8528_EC_MAX_RETRY);
-	return -EBUSY;
+	return qnap8528_ec_wait_status(QNAP8528_EC_STAGE_OBF_SET, QNAP8528_EC_STATUS_OBF, QNAP8528_EC_STATUS_OBF, false);
 }
 
 static int qnap8528_ec_send_command(u16 command)
 {
+	struct qnap8528_ec_xact *xact = &qnap8528_ec_queue.xact;
 	int ret;
 
 	ret = qnap8528_ec_wait_ibf_clear();
@@ -252,14 +411,34 @@ static int qnap8528_ec_send_command(u16 command)
 	outb(command & 0xff, QNAP8528_EC_DAT_PORT);
 
 ec_send_cmd_out:
+	trace_qnap8528_ec_send_command(xact->seq, command, xact->data, xact->retries,
+				       ktime_to_ns(ktime_sub(ktime_get(), xact->start)), ret);
 	return ret;
 }
 
-static int qnap8528_ec_read(u16 command, u8 *data)
+/*
+ * The __qnap8528_ec_* helpers drive the EC ports directly and must only run
+ * from the EC worker, which is the single owner of the ports.
+ */
+static void __qnap8528_ec_xact_start(u16 command, u8 data)
+{
+	struct qnap8528_ec_xact *xact = &qnap8528_ec_queue.xact;
+
+	xact->command = command;
+	xact->data = data;
+	xact->retries = 0;
+	xact->max_wait_ns = 0;
+	xact->start = ktime_get();
+	xact->deadline = ktime_add_ms(xact->start, qnap8528_ec_timeout_ms);
+}
+
+static int __qnap8528_ec_read(u16 command, u8 *data)
 {
+	struct qnap8528_ec_xact *xact = &qnap8528_ec_queue.xact;
 	int ret;
 
-	mutex_lock(&qnap8528_ec_lock);
+	__qnap8528_ec_xact_start(command, 0);
+
 	ret = qnap8528_ec_clear_obf();
 	if (ret)
 		goto ec_read_out;
@@ -274,267 +453,1251 @@ static int qnap8528_ec_read(u16 command, u8 *data)
 
 	*data = inb(QNAP8528_EC_DAT_PORT);
 
-
 ec_read_out:
-	mutex_unlock(&qnap8528_ec_lock);
+	trace_qnap8528_ec_read(xact->seq, command, ret ? 0 : *data, xact->retries,
+			       ktime_to_ns(ktime_sub(ktime_get(), xact->start)), ret);
 	return ret;
 }
 
-static int qnap8528_ec_write(u16 command, u8 data)
+static int __qnap8528_ec_write(u16 command, u8 data)
 {
+	struct qnap8528_ec_xact *xact = &qnap8528_ec_queue.xact;
 	int ret;
 
-	mutex_lock(&qnap8528_ec_lock);
+	__qnap8528_ec_xact_start(command, data);
+
 	ret = qnap8528_ec_send_command(command | 0x8000);
 	if (ret)
-		goto qnap8528_ec_read_out;
+		goto ec_write_out;
 
 	ret = qnap8528_ec_wait_ibf_clear();
 	if (ret)
-		goto qnap8528_ec_read_out;
+		goto ec_write_out;
 
 	outb(data, QNAP8528_EC_DAT_PORT);
 
-qnap8528_ec_read_out:
-	mutex_unlock(&qnap8528_ec_lock);
+ec_write_out:
+	trace_qnap8528_ec_write(xact->seq, command, data, xact->retries,
+				ktime_to_ns(ktime_sub(ktime_get(), xact->start)), ret);
 	return ret;
 }
 
-static umode_t qnap8528_ec_attr_check_visible(struct kobject *kobj, struct attribute *attr, int n)
+static int __qnap8528_ec_update_bits(u16 command, u8 mask, u8 val, bool force)
 {
-	struct qnap8528_dev_data *data = dev_get_drvdata(container_of(kobj, struct device, kobj));
+	u8 orig, tmp;
+	int ret;
 
-	if ((!data->config->features.eup_mode) && (strcmp(attr->name, "eup_mode") == 0))
-		return 0;
+	ret = __qnap8528_ec_read(command, &orig);
+	if (ret)
+		return ret;
 
-	if ((!data->config->features.pwr_recovery) && (strcmp(attr->name, "power_recovery") == 0))
+	tmp = (orig & ~mask) | (val & mask);
+	if (!force && tmp == orig)
 		return 0;
 
-	return attr->mode;
+	return __qnap8528_ec_write(command, tmp);
 }
 
-static ssize_t qnap8528_fw_version_attr_show(struct device *dev, struct device_attribute *attr, char *buf)
+static int __qnap8528_ec_transfer(struct qnap8528_ec_xfer *xfers, int count)
 {
-	u8 value;
-	int i;
-	ssize_t ret;
-	int read = 0;
+	int i, ret;
 
-	for (i = 0; i <  QNAP8528_EC_FW_VER_LEN; i++) {
-		ret = qnap8528_ec_read(QNAP8528_EC_FW_VER_REG + i, &value);
+	for (i = 0; i < count; i++) {
+		if (xfers[i].update)
+			ret = __qnap8528_ec_update_bits(xfers[i].reg, xfers[i].mask, xfers[i].val, xfers[i].force);
+		else if (xfers[i].write)
+			ret = __qnap8528_ec_write(xfers[i].reg, xfers[i].val);
+		else
+			ret = __qnap8528_ec_read(xfers[i].reg, &xfers[i].val);
 		if (ret)
 			return ret;
-		read += scnprintf(buf + i, PAGE_SIZE - i, "%c", value);
 	}
 
-	return read;
+	return 0;
 }
 
-static ssize_t qnap8528_cpld_version_attr_show(struct device *dev, struct device_attribute *attr, char *buf)
+/*
+ * Pick the next request, interactive before periodic before bulk. A lower
+ * class that has been waiting for too long is served first so a sustained
+ * stream of higher class requests can not starve it. The wait counts from
+ * when the request was last queued, a long request that just yielded has
+ * been served and waits its turn again.
+ */
+static struct qnap8528_ec_req *qnap8528_ec_queue_pop(u32 *seq, ktime_t *submitted)
 {
-	u8 value;
-	int ret;
+	struct qnap8528_ec_req *req = NULL, *head;
+	ktime_t starved = ktime_sub(ktime_get(), ms_to_ktime(QNAP8528_EC_STARVE_MS));
+	int i;
 
-	ret = qnap8528_ec_read(QNAP8528_CPLD_VER_REG, &value);
-	if (ret)
-		return ret;
-	return scnprintf(buf, PAGE_SIZE, "0x%x", value);
+	spin_lock(&qnap8528_ec_queue.lock);
+	for (i = 0; i < QNAP8528_EC_CLASS_MAX; i++) {
+		head = list_first_entry_or_null(&qnap8528_ec_queue.pending[i], struct qnap8528_ec_req, node);
+		if (!head)
+			continue;
+
+		if (!req) {
+			req = head;
+		} else if (ktime_before(head->queued, starved)) {
+			req = head;
+			break;
+		}
+	}
+	if (req) {
+		list_del_init(&req->node);
+		/* A slot request can be queued again while it runs, which restamps these */
+		*seq = req->seq;
+		*submitted = req->submitted;
+		/* Take the latest state, the slot can be filled again while this one runs */
+		if (req->slot) {
+			memcpy(req->slot->run, req->slot->next, req->slot->next_count * sizeof(*req->xfers));
+			req->count = req->slot->next_count;
+			req->pos = 0;
+			req->slot->queued = false;
+		}
+	}
+	spin_unlock(&qnap8528_ec_queue.lock);
+
+	return req;
 }
 
-static ssize_t qnap8528_power_recovery_attr_show(struct device *dev, struct device_attribute *attr, char *buf)
+/* Whether a request of a higher class than @class is waiting */
+static bool qnap8528_ec_queue_preempt(enum qnap8528_ec_class class)
 {
-	ssize_t ret;
-	u8 val;
+	bool ret = false;
+	int i;
 
-	ret = qnap8528_ec_read(QNAP8528_PWR_RECOVERY_REG, &val);
-	if (ret)
-		return ret;
-	return scnprintf(buf, PAGE_SIZE, "%d", val);
+	spin_lock(&qnap8528_ec_queue.lock);
+	for (i = 0; i < class && !ret; i++)
+		ret = !list_empty(&qnap8528_ec_queue.pending[i]);
+	spin_unlock(&qnap8528_ec_queue.lock);
+
+	return ret;
 }
 
-static ssize_t qnap8528_power_recovery_attr_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
+static enum qnap8528_ec_range qnap8528_ec_reg_range(u16 reg)
 {
-	u8 val;
-	ssize_t ret;
+	if (reg >= QNAP8528_VPD_REG_FIRST && reg <= QNAP8528_VPD_REG_LAST)
+		return QNAP8528_EC_RANGE_VPD;
+	if (reg < 0x200)
+		return QNAP8528_EC_RANGE_CTRL;
+	if (reg < 0x300)
+		return QNAP8528_EC_RANGE_FAN;
+	if (reg < 0x400)
+		return QNAP8528_EC_RANGE_INFO;
+	if (reg >= QNAP8528_SENSOR_REG_FIRST && reg <= QNAP8528_SENSOR_REG_LAST)
+		return QNAP8528_EC_RANGE_SENSOR;
+	return QNAP8528_EC_RANGE_OTHER;
+}
 
-	ret = kstrtou8(buf, 10, &val);
-	if (ret)
-		return ret;
+static void qnap8528_ec_hist_add(u64 *hist, ktime_t delta)
+{
+	s64 us = ktime_to_us(delta);
 
-	/* Values are: 0 - Off, 1 - On, 2 - Last State */
-	if ((val < 0) || (val > 2))
-		return -ERANGE;
+	hist[min_t(int, us > 0 ? fls64(us) : 0, QNAP8528_EC_HIST_BUCKETS - 1)]++;
+}
 
-	ret = qnap8528_ec_write(QNAP8528_PWR_RECOVERY_REG, val);
-	if (ret)
-		return ret;
+/* Called only by the EC worker, which makes it the single writer of the stats */
+static void qnap8528_ec_stats_account(struct qnap8528_ec_req *req, ktime_t submitted, ktime_t end)
+{
+	struct qnap8528_ec_req_stats *stats;
+	bool write = false;
+	int i;
 
-	return count;
+	for (i = 0; i < req->count; i++)
+		write |= req->xfers[i].write || req->xfers[i].update;
+
+	stats = &qnap8528_ec_stats.reqs[write][qnap8528_ec_reg_range(req->count ? req->xfers[0].reg : 0)];
+	stats->count++;
+	if (req->status)
+		stats->errors++;
+	/* A request that yielded waited between its chunks too, not only before the first one */
+	qnap8528_ec_hist_add(stats->wait, ktime_sub(ktime_sub(end, submitted), req->hold));
+	qnap8528_ec_hist_add(stats->hold, req->hold);
+	qnap8528_ec_hist_add(stats->total, ktime_sub(end, submitted));
 }
 
-static ssize_t qnap8528_eup_mode_attr_show(struct device *dev, struct device_attribute *attr, char *buf)
+static void qnap8528_ec_queue_work(struct work_struct *work)
 {
-	u8 ret, val;
-
-	ret = qnap8528_ec_read(QNAP8528_EUP_SUPPORT_REG, &val);
-	if (ret)
-		return ret;
+	struct qnap8528_ec_req *req;
+	ktime_t submitted, start, end;
+	u32 seq;
+
+	while ((req = qnap8528_ec_queue_pop(&seq, &submitted))) {
+		qnap8528_ec_queue.xact.seq = seq;
+		/* A request resumed after yielding has not run from the start */
+		if (!req->pos)
+			req->hold = 0;
+		start = ktime_get();
+
+		/* Fail fast while the EC is unresponsive, only the recovery probe gets through */
+		if (READ_ONCE(qnap8528_ec_queue.health) != QNAP8528_EC_HEALTH_OK && req->fn != qnap8528_ec_req_probe)
+			req->status = -EIO;
+		else
+			req->status = req->fn(req);
+		end = ktime_get();
+		req->hold = ktime_add(req->hold, ktime_sub(end, start));
+
+		/* Yielded halfway, put it back in front of its class and serve the higher class first */
+		if (req->status == -EINPROGRESS) {
+			spin_lock(&qnap8528_ec_queue.lock);
+			req->queued = ktime_get();
+			list_add(&req->node, &qnap8528_ec_queue.pending[req->class]);
+			spin_unlock(&qnap8528_ec_queue.lock);
+			continue;
+		}
 
-	if (!(val & 0x08))
-		return -ENOTSUPP;
+		if (req->status == -EBUSY)
+			qnap8528_ec_trip();
+		qnap8528_ec_stats_account(req, submitted, end);
+		trace_qnap8528_ec_complete(seq, req->status, ktime_to_ns(ktime_sub(ktime_sub(end, submitted), req->hold)),
+					   ktime_to_ns(req->hold));
 
-	ret = qnap8528_ec_read(QNAP8528_EUP_MODE_REG, &val);
-	if (ret)
-		return ret;
+		if (!req->async) {
+			complete(&req->done);
+			continue;
+		}
 
-	return scnprintf(buf, PAGE_SIZE, "%d", (val & 0x08) ? 1 : 0);
+		if (req->status) {
+			pr_err_ratelimited("Asynchronous EC request failed (%d)", req->status);
+			spin_lock(&qnap8528_ec_queue.lock);
+			if (!req->slot->status)
+				req->slot->status = req->status;
+			spin_unlock(&qnap8528_ec_queue.lock);
+		}
+	}
 }
 
-static ssize_t qnap8528_eup_mode_attr_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
+/*
+ * VPD walks are bulk work and yield to everything else between bytes. Other
+ * writes always have someone waiting on a change (an LED, a PWM value, a sysfs
+ * store), reads are interactive too unless they belong to a sensor sweep.
+ */
+static enum qnap8528_ec_class qnap8528_ec_req_class(struct qnap8528_ec_req *req)
 {
-	u8 val, tmp;
-	int ret;
+	enum qnap8528_ec_range range = qnap8528_ec_reg_range(req->count ? req->xfers[0].reg : 0);
+	int i;
 
-	ret = qnap8528_ec_read(QNAP8528_EUP_SUPPORT_REG, &val);
-	if (ret)
-		return ret;
+	if (range == QNAP8528_EC_RANGE_VPD)
+		return QNAP8528_EC_CLASS_BULK;
 
-	if (!(val & 0x08))
-		return -ENOTSUPP;
+	for (i = 0; i < req->count; i++) {
+		if (req->xfers[i].write || req->xfers[i].update)
+			return QNAP8528_EC_CLASS_INTERACTIVE;
+	}
 
-	ret = kstrtou8(buf, 10, &val);
-	if (ret)
-		return ret;
+	if (range == QNAP8528_EC_RANGE_FAN || range == QNAP8528_EC_RANGE_SENSOR)
+		return QNAP8528_EC_CLASS_PERIODIC;
 
-	ret = qnap8528_ec_read(QNAP8528_EUP_MODE_REG, &tmp);
-	if (ret)
-		return ret;
+	return QNAP8528_EC_CLASS_INTERACTIVE;
+}
 
-	tmp &= 0xf7;
-	tmp |= val ? 0x08 : 0x00;
+static void qnap8528_ec_submit(struct qnap8528_ec_req *req)
+{
+	req->submitted = ktime_get();
+	req->class = qnap8528_ec_req_class(req);
+
+	spin_lock(&qnap8528_ec_queue.lock);
+	if (qnap8528_ec_queue.stopping) {
+		spin_unlock(&qnap8528_ec_queue.lock);
+		req->status = -ESHUTDOWN;
+		complete(&req->done);
+		return;
+	}
+	req->seq = qnap8528_ec_queue.seq++;
+	req->queued = req->submitted;
+	list_add_tail(&req->node, &qnap8528_ec_queue.pending[req->class]);
+	spin_unlock(&qnap8528_ec_queue.lock);
 
-	/* Values are: 0 - Off, 1 - On*/
-	ret = qnap8528_ec_write(QNAP8528_EUP_MODE_REG, tmp);
-	if (ret)
-		return ret;
+	trace_qnap8528_ec_submit(req->seq, req->count ? req->xfers[0].reg : 0, req->count, req->class, req->async);
 
-	return count;
+	queue_work(qnap8528_ec_queue.wq, &qnap8528_ec_queue.work);
 }
 
-static ssize_t qnap8528_vpd_attr_show(struct device *dev, struct qnap8528_device_attribute *attr, char *buf)
+static int qnap8528_ec_submit_wait(struct qnap8528_ec_req *req)
 {
-	u16 i, reg_a, reg_b, reg_c, offs;
-	char raw[QNAP8528_VPD_ENTRY_MAX + 1] = {0};
-	u32 entry = attr->vpd_entry;
-	struct qnap8528_dev_data *data;
+	bool queued;
 
-	if (dev && (entry == 0xdeadbeef)) {
-		data = dev_get_drvdata(dev);
-		if (data->config->features.enc_serial_mb)
-			entry = QNAP8528_VPD_ENC_SER_MB;
-		else
-			entry = QNAP8528_VPD_ENC_SER_BP;
-	}
-	switch ((entry >> 0x1a) & 3) {
-	case 0:
-		reg_a = 0x56;
-		reg_b = 0x57;
-		reg_c = 0x58;
-		break;
-	case 1:
-		reg_a = 0x59;
-		reg_b = 0x5a;
-		reg_c = 0x5b;
-		break;
-	case 2:
-		reg_a = 0x5c;
-		reg_b = 0x5d;
-		reg_c = 0x5e;
-		break;
-	case 3:
-		reg_a = 0x60;
-		reg_b = 0x61;
-		reg_c = 0x62;
-		break;
-	default:
-		return -EINVAL;
-	}
+	if (READ_ONCE(qnap8528_ec_queue.health) != QNAP8528_EC_HEALTH_OK && req->fn != qnap8528_ec_req_probe)
+		return -EIO;
 
-	for (i = 0; i < ((entry >> 0x10) & 0xff); i++) {
-		offs = (entry & 0xffff) + i;
-		if (qnap8528_ec_write(reg_a, (offs >> 8) & 0xff) || qnap8528_ec_write(reg_b, offs & 0xff) || qnap8528_ec_read(reg_c, &raw[i]))
-			return -EBUSY;
-		udelay(5000);
-	}
+	init_completion(&req->done);
+	qnap8528_ec_submit(req);
+	if (!wait_for_completion_killable(&req->done))
+		return req->status;
 
-	return qnap8528_vpd_parse((entry >> 0x18) & 3, (entry >> 0x10) & 0xff, raw, buf);
+	/* Killed, take the request back if the worker has not picked it up yet */
+	spin_lock(&qnap8528_ec_queue.lock);
+	queued = !list_empty(&req->node);
+	if (queued)
+		list_del_init(&req->node);
+	spin_unlock(&qnap8528_ec_queue.lock);
+
+	if (queued)
+		return -EINTR;
+
+	/* Already running, it lives on our stack so wait, the deadline bounds this */
+	wait_for_completion(&req->done);
+	return req->status;
 }
 
-static ssize_t qnap8528_vpd_parse(int type, int size, char *raw, char *buf)
+/*
+ * Called by the worker when a transaction missed its deadline, stop sending
+ * requests to the EC and probe it in the background until it answers again.
+ */
+static void qnap8528_ec_trip(void)
 {
-	int ret = 0;
-	u16 i, offs;
-	time64_t ts, time_bytes = 0;
-
-	switch (type) {
-	case 0: /* String */
-		strncpy(buf, raw, size);
-		buf[size + 1] = '\x0';
-		ret =  size + 1;
-		break;
-	case 1: /* Number */
-		ret += scnprintf(buf, PAGE_SIZE, "0x");
-		for (i = 0; i < size; i++) {
-			offs = (i + 1) * 2;
-			ret += scnprintf(buf + offs, PAGE_SIZE - offs, "%02x", raw[size - i - 1]);
-		}
-		break;
-	case 2: /* Date */
-		memcpy(&time_bytes, raw, size);
-		ts = mktime64(2013, 1, 1, 0, 0, 0) + (time_bytes * 0x3c);
-		ret += scnprintf(buf, PAGE_SIZE, "%ptTs", &ts);
-		break;
-	default:
-		ret = -EINVAL;
+	if (READ_ONCE(qnap8528_ec_queue.health) == QNAP8528_EC_HEALTH_OK) {
+		qnap8528_ec_queue.trips++;
+		pr_err("EC is not responding, failing requests until it recovers");
 	}
 
-	return ret;
+	WRITE_ONCE(qnap8528_ec_queue.health, QNAP8528_EC_HEALTH_TRIPPED);
+	/* The probe would outlive the module */
+	if (READ_ONCE(qnap8528_ec_queue.stopping))
+		return;
+	mod_delayed_work(system_wq, &qnap8528_ec_queue.recover, msecs_to_jiffies(QNAP8528_EC_PROBE_MS));
 }
 
-static ssize_t blink_bicolor_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
+static int qnap8528_ec_req_probe(struct qnap8528_ec_req *req)
 {
 	int ret;
+	u8 val;
 
-	if (count > 0)
-		ret = qnap8528_ec_write(QNAP8528_LED_STATUS_REG, 5);
-	return ret ? ret : count;
+	/* Resync the handshake, drop anything the EC left behind and let it take input */
+	__qnap8528_ec_xact_start(0, 0);
+	ret = qnap8528_ec_clear_obf();
+	if (ret)
+		return ret;
+
+	ret = qnap8528_ec_wait_ibf_clear();
+	if (ret)
+		return ret;
+
+	ret = __qnap8528_ec_read(QNAP8528_CPLD_VER_REG, &val);
+	if (ret)
+		return ret;
+
+	WRITE_ONCE(qnap8528_ec_queue.health, QNAP8528_EC_HEALTH_OK);
+	return 0;
 }
 
-static int qnap8528_led_status_set(struct led_classdev *cdev, enum led_brightness brightness)
+/*
+ * Time a few reads of a harmless static register and set the spin window to
+ * twice the median of the slowest handshake stage of each read, so a single
+ * slow sample does not make every later access spin. The spin window in place
+ * when the request runs is the ceiling. A fast EC stops polling after a few
+ * microseconds, a slow one gets to spin long enough to avoid sleeping on every
+ * stage.
+ */
+static int qnap8528_ec_req_calibrate(struct qnap8528_ec_req *req)
 {
-	struct qnap8528_system_led *sled = container_of(cdev, struct qnap8528_system_led, cdev);
-
-	if (cdev->flags & LED_UNREGISTERING) {
-		if (!qnap8528_blink_sw_only)
-			device_remove_file(cdev->dev, &dev_attr_blink_bicolor);
+	struct qnap8528_ec_xact *xact = &qnap8528_ec_queue.xact;
+	u32 limit = READ_ONCE(qnap8528_ec_queue.timing.spin_us);
+	u64 wait_ns[QNAP8528_EC_CALIBRATE_ROUNDS];
+	int i, j, ret;
+	u8 val;
 
-		if (qnap8528_preserve_leds)
-			return 0;
-	}
+	/* Insertion sort as the samples come in, there are only a few */
+	for (i = 0; i < QNAP8528_EC_CALIBRATE_ROUNDS; i++) {
+		ret = __qnap8528_ec_read(QNAP8528_CPLD_VER_REG, &val);
+		if (ret)
+			return ret;
 
-	if (brightness) {
-		if(sled->is_hw_blink)
-			qnap8528_ec_write(QNAP8528_LED_STATUS_REG, brightness  == 1 ? 3 : 4);
-		else
-			qnap8528_ec_write(QNAP8528_LED_STATUS_REG, brightness);
-	} else {
-		sled->is_hw_blink = false;
-		qnap8528_ec_write(QNAP8528_LED_STATUS_REG, 0);
+		for (j = i; j > 0 && wait_ns[j - 1] > xact->max_wait_ns; j--)
+			wait_ns[j] = wait_ns[j - 1];
+		wait_ns[j] = xact->max_wait_ns;
 	}
 
+	WRITE_ONCE(qnap8528_ec_queue.timing.spin_us,
+		   clamp_t(u32, 2 * DIV_ROUND_UP_ULL(wait_ns[QNAP8528_EC_CALIBRATE_ROUNDS / 2], NSEC_PER_USEC),
+			   QNAP8528_EC_SPIN_MIN_US, max_t(u32, limit, QNAP8528_EC_SPIN_MIN_US)));
 	return 0;
 }
 
+static void qnap8528_ec_calibrate(const struct qnap8528_config *config)
+{
+	struct qnap8528_ec_timing timing = QNAP8528_EC_TIMING_DEFAULT;
+	struct qnap8528_ec_req req = {
+		.fn = qnap8528_ec_req_calibrate,
+	};
+
+	if (config->timing.spin_us)
+		timing.spin_us = config->timing.spin_us;
+	if (config->timing.sleep_ms)
+		timing.sleep_ms = config->timing.sleep_ms;
+
+	/*
+	 * A model profile is the ceiling for calibration, models without one are
+	 * capped at QNAP8528_EC_SPIN_MAX_US. Keep the profile if it fails.
+	 */
+	WRITE_ONCE(qnap8528_ec_queue.timing.spin_us, config->timing.spin_us ? : QNAP8528_EC_SPIN_MAX_US);
+	if (qnap8528_ec_submit_wait(&req)) {
+		pr_warn("EC timing calibration failed, using %s profile", config->name);
+		WRITE_ONCE(qnap8528_ec_queue.timing.spin_us, timing.spin_us);
+	}
+	WRITE_ONCE(qnap8528_ec_queue.timing.sleep_ms, timing.sleep_ms);
+
+	pr_info("EC timing: spin %u us, sleep %u ms", READ_ONCE(qnap8528_ec_queue.timing.spin_us),
+		READ_ONCE(qnap8528_ec_queue.timing.sleep_ms));
+}
+
+static void qnap8528_ec_recover_work(struct work_struct *work)
+{
+	struct qnap8528_ec_req req = {
+		.fn = qnap8528_ec_req_probe,
+	};
+
+	WRITE_ONCE(qnap8528_ec_queue.health, QNAP8528_EC_HEALTH_PROBING);
+	if (!qnap8528_ec_submit_wait(&req))
+		pr_info("EC is responding again");
+	else if (req.status != -EBUSY)
+		qnap8528_ec_trip();
+}
+
+/*
+ * Sweeps and scans are single requests of dozens of accesses, give the EC to a
+ * waiting higher class request between accesses so a button or LED does not
+ * wait for the whole sweep. Tied accesses (both halves of an RPM value) are
+ * never split. Interactive requests, which includes the slots, never yield.
+ */
+static int qnap8528_ec_req_transfer(struct qnap8528_ec_req *req)
+{
+	int n, ret;
+
+	while (req->pos < req->count) {
+		for (n = 1; req->pos + n < req->count && req->xfers[req->pos + n].tied; n++)
+			;
+
+		ret = __qnap8528_ec_transfer(&req->xfers[req->pos], n);
+		if (ret)
+			return ret;
+		req->pos += n;
+
+		if (req->pos < req->count && qnap8528_ec_queue_preempt(req->class))
+			return -EINPROGRESS;
+	}
+
+	return 0;
+}
+
+/*
+ * Run a sequence of register accesses as a single EC request, read values are
+ * returned in place. Nothing else can touch the EC in between so multi-byte
+ * values can not tear.
+ */
+static int qnap8528_ec_transfer(struct qnap8528_ec_xfer *xfers, int count)
+{
+	struct qnap8528_ec_req req = {
+		.fn = qnap8528_ec_req_transfer,
+		.xfers = xfers,
+		.count = count,
+	};
+
+	return qnap8528_ec_submit_wait(&req);
+}
+
+/*
+ * Queue a sequence of register writes on a slot and return without waiting for
+ * the EC, for callers that have no use for the result. A full new state
+ * (@replace) drops the writes still waiting, anything else is added after them
+ * and fails with -EBUSY once the slot is full. An error of an earlier run is
+ * returned by the next submission.
+ */
+static int qnap8528_ec_slot_submit(struct qnap8528_ec_slot *slot, const struct qnap8528_ec_xfer *xfers, int count,
+				   bool replace)
+{
+	struct qnap8528_ec_req *req = &slot->req;
+	bool queue;
+	u32 seq;
+	int ret;
+
+	if (!count)
+		return 0;
+
+	if (READ_ONCE(qnap8528_ec_queue.health) != QNAP8528_EC_HEALTH_OK)
+		return -EIO;
+
+	spin_lock(&qnap8528_ec_queue.lock);
+	if (qnap8528_ec_queue.stopping) {
+		spin_unlock(&qnap8528_ec_queue.lock);
+		return -ESHUTDOWN;
+	}
+
+	if (replace || !slot->queued)
+		slot->next_count = 0;
+	if (slot->next_count + count > QNAP8528_EC_SLOT_XFERS) {
+		spin_unlock(&qnap8528_ec_queue.lock);
+		return -EBUSY;
+	}
+
+	memcpy(&slot->next[slot->next_count], xfers, count * sizeof(*xfers));
+	slot->next_count += count;
+	ret = slot->status;
+	slot->status = 0;
+
+	/*
+	 * The request may still be running its previous state, the worker took
+	 * its own copy of seq and submitted when it picked it up, and count and
+	 * pos are only set by qnap8528_ec_queue_pop().
+	 */
+	queue = !slot->queued;
+	if (queue) {
+		req->submitted = ktime_get();
+		req->seq = qnap8528_ec_queue.seq++;
+		seq = req->seq;
+		req->queued = req->submitted;
+		list_add_tail(&req->node, &qnap8528_ec_queue.pending[req->class]);
+		slot->queued = true;
+	}
+	spin_unlock(&qnap8528_ec_queue.lock);
+
+	if (queue) {
+		trace_qnap8528_ec_submit(seq, xfers[0].reg, count, req->class, true);
+		queue_work(qnap8528_ec_queue.wq, &qnap8528_ec_queue.work);
+	}
+
+	return ret;
+}
+
+/* Wait for the worker to run whatever the slot still has queued */
+static void qnap8528_ec_slot_flush(void *data)
+{
+	flush_work(&qnap8528_ec_queue.work);
+}
+
+/*
+ * Slots live in device managed memory. Call this after allocating the slot and
+ * before registering what uses it, so on unload the flush runs once that LED
+ * or hwmon device is gone (an LED turned off on the way out queues a write)
+ * and before the slot memory is freed.
+ */
+static int qnap8528_ec_slot_init(struct device *dev, struct qnap8528_ec_slot *slot)
+{
+	struct qnap8528_ec_req *req = &slot->req;
+
+	/* Set once, a submission only fills @next and queues the request */
+	INIT_LIST_HEAD(&req->node);
+	req->fn = qnap8528_ec_req_transfer;
+	req->xfers = slot->run;
+	req->async = true;
+	req->slot = slot;
+	/* Only LED and PWM writes use slots, see qnap8528_ec_req_class() */
+	req->class = QNAP8528_EC_CLASS_INTERACTIVE;
+
+	return devm_add_action(dev, qnap8528_ec_slot_flush, slot);
+}
+
+static int qnap8528_ec_read(u16 command, u8 *data)
+{
+	struct qnap8528_ec_xfer xfer = QNAP8528_EC_XFER_READ(command);
+	int ret;
+
+	ret = qnap8528_ec_transfer(&xfer, 1);
+	if (ret)
+		return ret;
+
+	*data = xfer.val;
+	return 0;
+}
+
+static int qnap8528_ec_write(u16 command, u8 data)
+{
+	struct qnap8528_ec_xfer xfer = QNAP8528_EC_XFER_WRITE(command, data);
+
+	return qnap8528_ec_transfer(&xfer, 1);
+}
+
+/*
+ * Read-modify-write a register as a single EC request so concurrent updates
+ * can not be lost, the write is skipped if the value does not change.
+ */
+static int qnap8528_ec_update_bits(u16 command, u8 mask, u8 val)
+{
+	struct qnap8528_ec_xfer xfer = QNAP8528_EC_XFER_UPDATE(command, mask, val);
+
+	return qnap8528_ec_transfer(&xfer, 1);
+}
+
+static int qnap8528_ec_write_async(struct qnap8528_ec_slot *slot, u16 command, u8 data)
+{
+	struct qnap8528_ec_xfer xfer = QNAP8528_EC_XFER_WRITE(command, data);
+
+	return qnap8528_ec_slot_submit(slot, &xfer, 1, true);
+}
+
+static int qnap8528_regmap_reg_read(void *context, unsigned int reg, unsigned int *val)
+{
+	u8 value;
+	int ret;
+
+	ret = qnap8528_ec_read(reg, &value);
+	if (ret)
+		return ret;
+
+	*val = value;
+	return 0;
+}
+
+static int qnap8528_regmap_reg_write(void *context, unsigned int reg, unsigned int val)
+{
+	return qnap8528_ec_write(reg, val);
+}
+
+static int qnap8528_regmap_reg_update_bits(void *context, unsigned int reg, unsigned int mask, unsigned int val)
+{
+	return qnap8528_ec_update_bits(reg, mask, val);
+}
+
+static void qnap8528_ec_stats_show_hist(struct seq_file *s, const char *name, const u64 *hist)
+{
+	int i;
+
+	seq_printf(s, "  %-6s", name);
+	for (i = 0; i < QNAP8528_EC_HIST_BUCKETS; i++) {
+		if (hist[i])
+			seq_printf(s, " %lluus:%llu", i ? 1ULL << (i - 1) : 0, hist[i]);
+	}
+	seq_putc(s, '\n');
+}
+
+static int qnap8528_ec_stats_show(struct seq_file *s, void *unused)
+{
+	static const char * const stage_names[] = { "ibf_clear", "obf_clear", "obf_set" };
+	static const char * const range_names[] = { "ctrl", "vpd", "fan", "info", "sensor", "other" };
+	struct qnap8528_ec_stage_stats *stage;
+	struct qnap8528_ec_req_stats *req;
+	int i, j;
+
+	seq_printf(s, "timing: spin %u us, sleep %u ms\n\n",
+		   READ_ONCE(qnap8528_ec_spin_us) ?: READ_ONCE(qnap8528_ec_queue.timing.spin_us),
+		   READ_ONCE(qnap8528_ec_sleep_ms) ?: READ_ONCE(qnap8528_ec_queue.timing.sleep_ms));
+	seq_printf(s, "%-10s %12s %12s %12s %10s\n", "stage", "calls", "retries", "max_retries", "timeouts");
+	for (i = 0; i < QNAP8528_EC_STAGE_MAX; i++) {
+		stage = &qnap8528_ec_stats.stages[i];
+		seq_printf(s, "%-10s %12llu %12llu %12llu %10llu\n", stage_names[i],
+			   stage->calls, stage->retries, stage->max_retries, stage->timeouts);
+	}
+
+	/* Histogram buckets are labeled with their lower bound, each covers up to twice that */
+	for (i = 0; i < 2; i++) {
+		for (j = 0; j < QNAP8528_EC_RANGE_MAX; j++) {
+			req = &qnap8528_ec_stats.reqs[i][j];
+			if (!req->count)
+				continue;
+
+			seq_printf(s, "\n%s %s: requests %llu errors %llu\n", i ? "write" : "read",
+				   range_names[j], req->count, req->errors);
+			qnap8528_ec_stats_show_hist(s, "wait", req->wait);
+			qnap8528_ec_stats_show_hist(s, "hold", req->hold);
+			qnap8528_ec_stats_show_hist(s, "total", req->total);
+		}
+	}
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(qnap8528_ec_stats);
+
+static void qnap8528_debugfs_remove(void *dir)
+{
+	debugfs_remove_recursive(dir);
+}
+
+static int qnap8528_register_debugfs(struct device *dev)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+
+	data->debugfs = debugfs_create_dir(dev_name(dev), NULL);
+	debugfs_create_file("ec_stats", 0444, data->debugfs, NULL, &qnap8528_ec_stats_fops);
+
+	return devm_add_action_or_reset(dev, qnap8528_debugfs_remove, data->debugfs);
+}
+
+static int qnap8528_ec_queue_init(void)
+{
+	int i;
+
+	spin_lock_init(&qnap8528_ec_queue.lock);
+	for (i = 0; i < QNAP8528_EC_CLASS_MAX; i++)
+		INIT_LIST_HEAD(&qnap8528_ec_queue.pending[i]);
+	INIT_WORK(&qnap8528_ec_queue.work, qnap8528_ec_queue_work);
+	INIT_DELAYED_WORK(&qnap8528_ec_queue.recover, qnap8528_ec_recover_work);
+	qnap8528_ec_queue.timing = (struct qnap8528_ec_timing)QNAP8528_EC_TIMING_ENE;
+
+	qnap8528_ec_queue.wq = alloc_ordered_workqueue(DRVNAME, WQ_HIGHPRI);
+	if (!qnap8528_ec_queue.wq)
+		return -ENOMEM;
+
+	return 0;
+}
+
+static void qnap8528_ec_queue_destroy(void)
+{
+	spin_lock(&qnap8528_ec_queue.lock);
+	qnap8528_ec_queue.stopping = true;
+	spin_unlock(&qnap8528_ec_queue.lock);
+
+	cancel_delayed_work_sync(&qnap8528_ec_queue.recover);
+	/* Drains any request still queued, such as LED writes on unload */
+	destroy_workqueue(qnap8528_ec_queue.wq);
+	/* A drained request may have tripped the breaker before it saw stopping */
+	cancel_delayed_work_sync(&qnap8528_ec_queue.recover);
+}
+
+static umode_t qnap8528_ec_attr_check_visible(struct kobject *kobj, struct attribute *attr, int n)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(container_of(kobj, struct device, kobj));
+
+	if ((!data->config->features.eup_mode) && (strcmp(attr->name, "eup_mode") == 0))
+		return 0;
+
+	if ((!data->config->features.pwr_recovery) && (strcmp(attr->name, "power_recovery") == 0))
+		return 0;
+
+	return attr->mode;
+}
+
+static ssize_t qnap8528_fw_version_attr_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	u8 value[QNAP8528_EC_FW_VER_LEN];
+	int i;
+	ssize_t ret;
+	int read = 0;
+
+	ret = regmap_bulk_read(data->regmap, QNAP8528_EC_FW_VER_REG, value, QNAP8528_EC_FW_VER_LEN);
+	if (ret)
+		return ret;
+
+	for (i = 0; i <  QNAP8528_EC_FW_VER_LEN; i++)
+		read += scnprintf(buf + i, PAGE_SIZE - i, "%c", value[i]);
+
+	return read;
+}
+
+static ssize_t qnap8528_cpld_version_attr_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	unsigned int value;
+	int ret;
+
+	ret = regmap_read(data->regmap, QNAP8528_CPLD_VER_REG, &value);
+	if (ret)
+		return ret;
+	return scnprintf(buf, PAGE_SIZE, "0x%x", value);
+}
+
+static ssize_t qnap8528_breaker_state_attr_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	static const char * const names[] = { "ok", "tripped", "probing" };
+
+	return scnprintf(buf, PAGE_SIZE, "%s\n", names[READ_ONCE(qnap8528_ec_queue.health)]);
+}
+
+static ssize_t qnap8528_breaker_trips_attr_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	return scnprintf(buf, PAGE_SIZE, "%u\n", READ_ONCE(qnap8528_ec_queue.trips));
+}
+
+static ssize_t qnap8528_power_recovery_attr_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	ssize_t ret;
+	unsigned int val;
+
+	ret = regmap_read(data->regmap, QNAP8528_PWR_RECOVERY_REG, &val);
+	if (ret)
+		return ret;
+	return scnprintf(buf, PAGE_SIZE, "%d", val);
+}
+
+static ssize_t qnap8528_power_recovery_attr_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	u8 val;
+	ssize_t ret;
+
+	ret = kstrtou8(buf, 10, &val);
+	if (ret)
+		return ret;
+
+	/* Values are: 0 - Off, 1 - On, 2 - Last State */
+	if ((val < 0) || (val > 2))
+		return -ERANGE;
+
+	ret = regmap_write(data->regmap, QNAP8528_PWR_RECOVERY_REG, val);
+	if (ret)
+		return ret;
+
+	return count;
+}
+
+static ssize_t qnap8528_eup_mode_attr_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	unsigned int val;
+	int ret;
+
+	ret = regmap_read(data->regmap, QNAP8528_EUP_SUPPORT_REG, &val);
+	if (ret)
+		return ret;
+
+	if (!(val & 0x08))
+		return -ENOTSUPP;
+
+	ret = regmap_read(data->regmap, QNAP8528_EUP_MODE_REG, &val);
+	if (ret)
+		return ret;
+
+	return scnprintf(buf, PAGE_SIZE, "%d", (val & 0x08) ? 1 : 0);
+}
+
+static ssize_t qnap8528_eup_mode_attr_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	unsigned int tmp;
+	u8 val;
+	int ret;
+
+	ret = regmap_read(data->regmap, QNAP8528_EUP_SUPPORT_REG, &tmp);
+	if (ret)
+		return ret;
+
+	if (!(tmp & 0x08))
+		return -ENOTSUPP;
+
+	ret = kstrtou8(buf, 10, &val);
+	if (ret)
+		return ret;
+
+	/* Values are: 0 - Off, 1 - On*/
+	ret = regmap_update_bits(data->regmap, QNAP8528_EUP_MODE_REG, 0x08, val ? 0x08 : 0x00);
+	if (ret)
+		return ret;
+
+	return count;
+}
+
+/*
+ * The EC takes a moment to present the byte at a new VPD address, until then
+ * the data register still holds the previous byte (stale). A value different
+ * from it can only be the new byte. An equal one cannot be told apart, so it
+ * is taken once twice the longest delay seen for a byte to change has passed,
+ * or the full vpd_settle_us while nothing has been measured yet.
+ */
+static int qnap8528_vpd_settle(struct qnap8528_dev_data *data, u16 reg, unsigned int stale, unsigned int *val)
+{
+	unsigned int wait = READ_ONCE(qnap8528_vpd_settle_us);
+	ktime_t start = ktime_get();
+	s64 elapsed;
+	int ret;
+
+	if (data->vpd_settle_us)
+		wait = min(wait, 2 * data->vpd_settle_us);
+
+	for (;;) {
+		ret = regmap_read(data->regmap, reg, val);
+		if (ret)
+			return ret;
+
+		elapsed = ktime_us_delta(ktime_get(), start);
+		if (*val != stale) {
+			data->vpd_settle_us = max_t(unsigned int, data->vpd_settle_us, clamp_t(s64, elapsed, 1, U16_MAX));
+			return 0;
+		}
+
+		if (elapsed >= wait)
+			return 0;
+
+		usleep_range(QNAP8528_EC_SLEEP_MIN_US, QNAP8528_EC_SLEEP_MAX_US);
+	}
+}
+
+/*
+ * Walks the EC one byte at a time. The caller holds vpd_lock for the whole
+ * walk so nobody else can move the address pointer in the middle of it. The
+ * high address byte is only written when it changes, the cached value is
+ * dropped first so a walk never trusts what the EC held before a refresh or
+ * a breaker trip.
+ */
+static int __qnap8528_vpd_fetch(struct qnap8528_dev_data *data, int table, u16 offs, u16 len, u8 *raw)
+{
+	u16 i, reg_a, reg_b, reg_c;
+	unsigned int val;
+	int ret;
+
+	switch (table) {
+	case 0:
+		reg_a = 0x56;
+		reg_b = 0x57;
+		reg_c = 0x58;
+		break;
+	case 1:
+		reg_a = 0x59;
+		reg_b = 0x5a;
+		reg_c = 0x5b;
+		break;
+	case 2:
+		reg_a = 0x5c;
+		reg_b = 0x5d;
+		reg_c = 0x5e;
+		break;
+	case 3:
+		reg_a = 0x60;
+		reg_b = 0x61;
+		reg_c = 0x62;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	ret = regcache_drop_region(data->regmap, reg_a, reg_b);
+	if (ret)
+		return ret;
+
+	/* Whatever the data register shows now is the stale value for the first byte */
+	ret = regmap_read(data->regmap, reg_c, &val);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < len; i++, offs++) {
+		ret = regmap_update_bits(data->regmap, reg_a, 0xff, (offs >> 8) & 0xff);
+		if (ret)
+			return ret;
+
+		ret = regmap_write(data->regmap, reg_b, offs & 0xff);
+		if (ret)
+			return ret;
+
+		ret = qnap8528_vpd_settle(data, reg_c, val, &val);
+		if (ret)
+			return ret;
+		raw[i] = val;
+	}
+
+	return 0;
+}
+
+/* Reads an entry straight from the EC, bypassing the snapshot */
+static int qnap8528_vpd_read(struct qnap8528_dev_data *data, u32 entry, char *raw)
+{
+	int ret;
+
+	/* Only one reader may move the VPD address at a time */
+	if (mutex_lock_killable(&data->vpd_lock))
+		return -EINTR;
+
+	ret = __qnap8528_vpd_fetch(data, QNAP8528_VPD_TABLE(entry), QNAP8528_VPD_OFFSET(entry),
+				   QNAP8528_VPD_LEN(entry), raw);
+	mutex_unlock(&data->vpd_lock);
+
+	return ret;
+}
+
+/* Loads a whole table into the snapshot if it is not there yet, the caller holds vpd_lock */
+static int qnap8528_vpd_snapshot(struct qnap8528_dev_data *data, int table)
+{
+	int ret;
+
+	if (test_bit(table, &data->vpd_valid))
+		return 0;
+
+	/* Kept until the device goes away, tables nobody reads never get one */
+	if (!data->vpd_tables[table]) {
+		data->vpd_tables[table] = devm_kmalloc(data->dev, QNAP8528_VPD_TABLE_SIZE, GFP_KERNEL);
+		if (!data->vpd_tables[table])
+			return -ENOMEM;
+	}
+
+	ret = __qnap8528_vpd_fetch(data, table, 0, QNAP8528_VPD_TABLE_SIZE, data->vpd_tables[table]);
+	if (ret)
+		return ret;
+
+	set_bit(table, &data->vpd_valid);
+	return 0;
+}
+
+/*
+ * Reads an entry from the snapshot, loading its table first if needed. The
+ * caller holds vpd_lock, so several lookups can share one session.
+ */
+static int __qnap8528_vpd_lookup(struct qnap8528_dev_data *data, u32 entry, char *raw)
+{
+	int table = QNAP8528_VPD_TABLE(entry);
+	u16 offs = QNAP8528_VPD_OFFSET(entry);
+	u16 len = QNAP8528_VPD_LEN(entry);
+	int ret;
+
+	if (offs + len > QNAP8528_VPD_TABLE_SIZE)
+		return -EINVAL;
+
+	ret = qnap8528_vpd_snapshot(data, table);
+	if (!ret)
+		memcpy(raw, data->vpd_tables[table] + offs, len);
+
+	return ret;
+}
+
+static int qnap8528_vpd_lookup(struct qnap8528_dev_data *data, u32 entry, char *raw)
+{
+	int ret;
+
+	if (mutex_lock_killable(&data->vpd_lock))
+		return -EINTR;
+	ret = __qnap8528_vpd_lookup(data, entry, raw);
+	mutex_unlock(&data->vpd_lock);
+
+	return ret;
+}
+
+/* The enclosure serial lives in a different table depending on the model */
+static u32 qnap8528_vpd_resolve(struct qnap8528_dev_data *data, u32 entry)
+{
+	if (entry != QNAP8528_VPD_ENC_SERIAL)
+		return entry;
+
+	return data->config->features.enc_serial_mb ? QNAP8528_VPD_ENC_SER_MB : QNAP8528_VPD_ENC_SER_BP;
+}
+
+static ssize_t qnap8528_vpd_table_read(struct file *filp, struct kobject *kobj, struct bin_attribute *attr,
+				       char *buf, loff_t off, size_t count)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(kobj_to_dev(kobj));
+	int table = (long)attr->private;
+	int ret;
+
+	/* sysfs already clamped off and count to the table size */
+	if (mutex_lock_killable(&data->vpd_lock))
+		return -EINTR;
+
+	ret = qnap8528_vpd_snapshot(data, table);
+	if (!ret)
+		memcpy(buf, data->vpd_tables[table] + off, count);
+	mutex_unlock(&data->vpd_lock);
+
+	return ret ? ret : count;
+}
+
+static ssize_t qnap8528_vpd_refresh_store(struct device *dev, struct qnap8528_device_attribute *attr, const char *buf, size_t count)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+
+	/* Drop the snapshot, the next read loads it again from the EC */
+	if (mutex_lock_killable(&data->vpd_lock))
+		return -EINTR;
+	data->vpd_valid = 0;
+	mutex_unlock(&data->vpd_lock);
+
+	return count;
+}
+
+static ssize_t qnap8528_vpd_attr_show(struct device *dev, struct qnap8528_device_attribute *attr, char *buf)
+{
+	char raw[QNAP8528_VPD_ENTRY_MAX + 1] = {0};
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	u32 entry = qnap8528_vpd_resolve(data, attr->vpd_entry);
+	int ret;
+
+	ret = qnap8528_vpd_lookup(data, entry, raw);
+	if (ret)
+		return ret;
+
+	return qnap8528_vpd_parse(QNAP8528_VPD_TYPE(entry), QNAP8528_VPD_LEN(entry), raw, buf, PAGE_SIZE);
+}
+
+/*
+ * Takes a whitespace separated list of entry codes, in the same encoding as
+ * the QNAP8528_VPD_* values, to be decoded on the next read of vpd/query.
+ */
+static ssize_t qnap8528_vpd_query_store(struct device *dev, struct qnap8528_device_attribute *attr, const char *buf, size_t count)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	u32 entries[QNAP8528_VPD_QUERY_MAX];
+	char *tmp, *cur, *tok;
+	int n = 0, ret = 0;
+	u32 entry;
+
+	tmp = kstrndup(buf, count, GFP_KERNEL);
+	if (!tmp)
+		return -ENOMEM;
+
+	cur = tmp;
+	while ((tok = strsep(&cur, " \t\n")) != NULL) {
+		if (!*tok)
+			continue;
+
+		if (n == QNAP8528_VPD_QUERY_MAX) {
+			ret = -E2BIG;
+			break;
+		}
+
+		ret = kstrtou32(tok, 0, &entry);
+		if (ret)
+			break;
+
+		/* Reject what the parser or the table bounds cannot handle before touching the EC */
+		entry = qnap8528_vpd_resolve(data, entry);
+		if (!QNAP8528_VPD_LEN(entry) || QNAP8528_VPD_TYPE(entry) > 2 ||
+		    (QNAP8528_VPD_TYPE(entry) == 2 && QNAP8528_VPD_LEN(entry) > sizeof(time64_t)) ||
+		    QNAP8528_VPD_OFFSET(entry) + QNAP8528_VPD_LEN(entry) > QNAP8528_VPD_TABLE_SIZE) {
+			ret = -EINVAL;
+			break;
+		}
+		entries[n++] = entry;
+	}
+	kfree(tmp);
+
+	if (ret)
+		return ret;
+
+	if (mutex_lock_killable(&data->vpd_lock))
+		return -EINTR;
+	memcpy(data->vpd_query, entries, n * sizeof(*entries));
+	data->vpd_query_count = n;
+	mutex_unlock(&data->vpd_lock);
+
+	return count;
+}
+
+/* Renders every known entry as "name=value" lines in one VPD session */
+static ssize_t qnap8528_vpd_all_show(struct device *dev, struct qnap8528_device_attribute *attr, char *buf)
+{
+	char raw[QNAP8528_VPD_ENTRY_MAX + 1];
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	struct qnap8528_device_attribute *vattr;
+	ssize_t ret = 0, len = 0;
+	struct attribute **a;
+	u32 entry;
+
+	if (mutex_lock_killable(&data->vpd_lock))
+		return -EINTR;
+
+	for (a = qnap8528_vpd_attrs; *a; a++) {
+		vattr = container_of(*a, struct qnap8528_device_attribute, attr);
+		if (!vattr->vpd_entry)
+			continue;
+
+		entry = qnap8528_vpd_resolve(data, vattr->vpd_entry);
+		memset(raw, 0, sizeof(raw));
+
+		ret = __qnap8528_vpd_lookup(data, entry, raw);
+		if (ret)
+			break;
+
+		len += scnprintf(buf + len, PAGE_SIZE - len, "%s=", (*a)->name);
+		ret = qnap8528_vpd_parse(QNAP8528_VPD_TYPE(entry), QNAP8528_VPD_LEN(entry), raw,
+					 buf + len, PAGE_SIZE - len);
+		if (ret < 0)
+			break;
+		len += ret;
+		len += scnprintf(buf + len, PAGE_SIZE - len, "\n");
+	}
+	mutex_unlock(&data->vpd_lock);
+
+	return ret < 0 ? ret : len;
+}
+
+/* Decodes every queried entry in one VPD session, one "entry=value" line each */
+static ssize_t qnap8528_vpd_query_show(struct device *dev, struct qnap8528_device_attribute *attr, char *buf)
+{
+	char raw[QNAP8528_VPD_ENTRY_MAX + 1];
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	ssize_t ret = 0, len = 0;
+	u32 entry;
+	int i;
+
+	if (mutex_lock_killable(&data->vpd_lock))
+		return -EINTR;
+
+	for (i = 0; i < data->vpd_query_count; i++) {
+		entry = data->vpd_query[i];
+		memset(raw, 0, sizeof(raw));
+
+		ret = __qnap8528_vpd_lookup(data, entry, raw);
+		if (ret)
+			break;
+
+		len += scnprintf(buf + len, PAGE_SIZE - len, "0x%08x=", entry);
+		ret = qnap8528_vpd_parse(QNAP8528_VPD_TYPE(entry), QNAP8528_VPD_LEN(entry), raw,
+					 buf + len, PAGE_SIZE - len);
+		if (ret < 0)
+			break;
+		len += ret;
+		len += scnprintf(buf + len, PAGE_SIZE - len, "\n");
+
+		/* A full page means the last line may be cut, fail rather than return part of a value */
+		if (len >= PAGE_SIZE - 1) {
+			ret = -E2BIG;
+			break;
+		}
+	}
+	mutex_unlock(&data->vpd_lock);
+
+	return ret < 0 ? ret : len;
+}
+
+static ssize_t qnap8528_vpd_parse(int type, int size, char *raw, char *buf, size_t len)
+{
+	int ret = 0;
+	u16 i;
+	time64_t ts, time_bytes = 0;
+
+	switch (type) {
+	case 0: /* String */
+		ret = scnprintf(buf, len, "%.*s", size, raw);
+		break;
+	case 1: /* Number */
+		ret += scnprintf(buf, len, "0x");
+		for (i = 0; i < size; i++)
+			ret += scnprintf(buf + ret, len - ret, "%02x", (u8)raw[size - i - 1]);
+		break;
+	case 2: /* Date */
+		if (size > sizeof(time_bytes))
+			return -EINVAL;
+		memcpy(&time_bytes, raw, size);
+		ts = mktime64(2013, 1, 1, 0, 0, 0) + (time_bytes * 0x3c);
+		ret += scnprintf(buf, len, "%ptTs", &ts);
+		break;
+	default:
+		ret = -EINVAL;
+	}
+
+	return ret;
+}
+
+static ssize_t blink_bicolor_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
+{
+	struct led_classdev *cdev = dev_get_drvdata(dev);
+	struct qnap8528_system_led *sled = container_of(cdev, struct qnap8528_system_led, cdev);
+	int ret = 0;
+
+	if (count > 0)
+		ret = qnap8528_ec_write_async(&sled->ec_slot, QNAP8528_LED_STATUS_REG, 5);
+	return ret ? ret : count;
+}
+
+static int qnap8528_led_status_set(struct led_classdev *cdev, enum led_brightness brightness)
+{
+	struct qnap8528_system_led *sled = container_of(cdev, struct qnap8528_system_led, cdev);
+
+	if (cdev->flags & LED_UNREGISTERING) {
+		if (!qnap8528_blink_sw_only)
+			device_remove_file(cdev->dev, &dev_attr_blink_bicolor);
+
+		if (qnap8528_preserve_leds)
+			return 0;
+	}
+
+	if (brightness) {
+		if(sled->is_hw_blink)
+			return qnap8528_ec_write_async(&sled->ec_slot, QNAP8528_LED_STATUS_REG, brightness  == 1 ? 3 : 4);
+		else
+			return qnap8528_ec_write_async(&sled->ec_slot, QNAP8528_LED_STATUS_REG, brightness);
+	}
+
+	sled->is_hw_blink = false;
+	return qnap8528_ec_write_async(&sled->ec_slot, QNAP8528_LED_STATUS_REG, 0);
+}
+
 static int qnap8528_led_status_blink(struct led_classdev *cdev, unsigned long *delay_on, unsigned long *delay_off)
 {
 	struct qnap8528_system_led *sled = container_of(cdev, struct qnap8528_system_led, cdev);
@@ -546,18 +1709,16 @@ static int qnap8528_led_status_blink(struct led_classdev *cdev, unsigned long *d
 	sled->is_hw_blink = true;
 
 	if (cdev->brightness == 2)
-		qnap8528_ec_write(QNAP8528_LED_STATUS_REG, 4);
+		return qnap8528_ec_write_async(&sled->ec_slot, QNAP8528_LED_STATUS_REG, 4);
 	else
-		qnap8528_ec_write(QNAP8528_LED_STATUS_REG, 3);
-
-	return 0;
+		return qnap8528_ec_write_async(&sled->ec_slot, QNAP8528_LED_STATUS_REG, 3);
 }
 
 static int qnap8528_led_usb_set(struct led_classdev *cdev, enum led_brightness brightness)
 {
 	if (qnap8528_preserve_leds && (cdev->flags & LED_UNREGISTERING))
 		return 0;
-	return qnap8528_ec_write(QNAP8528_LED_USB_REG, brightness ? 2 : 0);
+	return qnap8528_ec_write_async(&container_of(cdev, struct qnap8528_system_led, cdev)->ec_slot, QNAP8528_LED_USB_REG, brightness ? 2 : 0);
 }
 
 static int qnap8528_led_usb_blink(struct led_classdev *cdev, unsigned long *delay_on, unsigned long *delay_off)
@@ -566,7 +1727,7 @@ static int qnap8528_led_usb_blink(struct led_classdev *cdev, unsigned long *dela
 	if (!(*delay_on == 0 && *delay_off == 0) && (*delay_on < 280 || *delay_on > 470 || *delay_off < 280 || *delay_off > 470))
 		return -EINVAL;
 
-	return qnap8528_ec_write(QNAP8528_LED_USB_REG, 1);
+	return qnap8528_ec_write_async(&container_of(cdev, struct qnap8528_system_led, cdev)->ec_slot, QNAP8528_LED_USB_REG, 1);
 }
 
 static int qnap8528_led_ident_set(struct led_classdev *cdev, enum led_brightness brightness)
@@ -574,26 +1735,28 @@ static int qnap8528_led_ident_set(struct led_classdev *cdev, enum led_brightness
 	if (qnap8528_preserve_leds && (cdev->flags & LED_UNREGISTERING))
 		return 0;
 
-	return qnap8528_ec_write(QNAP8528_LED_IDENT_REG, brightness ? 1 : 2);
+	return qnap8528_ec_write_async(&container_of(cdev, struct qnap8528_system_led, cdev)->ec_slot, QNAP8528_LED_IDENT_REG, brightness ? 1 : 2);
 }
 
 static int qnap8528_led_jbod_set(struct led_classdev *cdev, enum led_brightness brightness)
 {
 	if (qnap8528_preserve_leds && (cdev->flags & LED_UNREGISTERING))
 		return 0;
-	return qnap8528_ec_write(QNAP8528_LED_JBOD_REG, !!brightness);
+	return qnap8528_ec_write_async(&container_of(cdev, struct qnap8528_system_led, cdev)->ec_slot, QNAP8528_LED_JBOD_REG, !!brightness);
 }
 
 static int qnap8528_led_10g_set(struct led_classdev *cdev, enum led_brightness brightness)
 {
 	if (qnap8528_preserve_leds && (cdev->flags & LED_UNREGISTERING))
 		return 0;
-	return qnap8528_ec_write(QNAP8528_LED_10G_REG, !!brightness);
+	return qnap8528_ec_write_async(&container_of(cdev, struct qnap8528_system_led, cdev)->ec_slot, QNAP8528_LED_10G_REG, !!brightness);
 }
 
 static int qnap8528_led_slot_set(struct led_classdev *cdev,	enum led_brightness brightness)
 {
 	struct qnap8528_slot_led *sled = container_of(cdev, struct qnap8528_slot_led, led_cdev);
+	struct qnap8528_ec_xfer xfers[QNAP8528_EC_SLOT_XFERS / 2];
+	int n = 0;
 
 	if (qnap8528_preserve_leds && (cdev->flags & LED_UNREGISTERING))
 		return 0;
@@ -605,16 +1768,16 @@ static int qnap8528_led_slot_set(struct led_classdev *cdev,	enum led_brightness
 
 	/* Start with a clean state, disable all LED states */
 	if (sled->is_hw_blink) {
-		if (sled->slot_cfg->has_active)
-			qnap8528_ec_write(EC_LED_DISK_ACTIVE_OFF_REG, sled->slot_cfg->ec_index);
-		if (sled->slot_cfg->has_locate)
-			qnap8528_ec_write(EC_LED_DISK_LOCATE_OFF_REG, sled->slot_cfg->ec_index);
+		if (sled->slot_cfg.has_active)
+			xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_ACTIVE_OFF_REG, sled->slot_cfg.ec_index);
+		if (sled->slot_cfg.has_locate)
+			xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_LOCATE_OFF_REG, sled->slot_cfg.ec_index);
 	}
 
-	if (sled->slot_cfg->has_present)
-		qnap8528_ec_write(EC_LED_DISK_PRESENT_OFF_REG, sled->slot_cfg->ec_index);
-	if (sled->slot_cfg->has_error)
-		qnap8528_ec_write(EC_LED_DISK_ERROR_OFF_REG, sled->slot_cfg->ec_index);
+	if (sled->slot_cfg.has_present)
+		xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_PRESENT_OFF_REG, sled->slot_cfg.ec_index);
+	if (sled->slot_cfg.has_error)
+		xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_ERROR_OFF_REG, sled->slot_cfg.ec_index);
 
 	/* What state do we want to achieve? */
 	switch((int)brightness) {
@@ -627,31 +1790,34 @@ static int qnap8528_led_slot_set(struct led_classdev *cdev,	enum led_brightness
 		 * If no present, we also dont care about activity since its needs present
 		 * to be ON
 		 */
-		if (sled->slot_cfg->has_present) {
-			qnap8528_ec_write(EC_LED_DISK_PRESENT_ON_REG, sled->slot_cfg->ec_index);
+		if (sled->slot_cfg.has_present) {
+			xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_PRESENT_ON_REG, sled->slot_cfg.ec_index);
 			
-			if (sled->is_hw_blink && sled->slot_cfg->has_active)
-				qnap8528_ec_write(EC_LED_DISK_ACTIVE_ON_REG, sled->slot_cfg->ec_index);
+			if (sled->is_hw_blink && sled->slot_cfg.has_active)
+				xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_ACTIVE_ON_REG, sled->slot_cfg.ec_index);
 
 			break;
 		}
 		__attribute__((__fallthrough__));
 	case 2:
 		/* Turn on error LED and blink if state was blinking */
-		if (sled->slot_cfg->has_error)
-			qnap8528_ec_write(EC_LED_DISK_ERROR_ON_REG, sled->slot_cfg->ec_index);
+		if (sled->slot_cfg.has_error)
+			xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_ERROR_ON_REG, sled->slot_cfg.ec_index);
 		
-		if (sled->is_hw_blink && sled->slot_cfg->has_locate)
-			qnap8528_ec_write(EC_LED_DISK_LOCATE_ON_REG, sled->slot_cfg->ec_index);
+		if (sled->is_hw_blink && sled->slot_cfg.has_locate)
+			xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_LOCATE_ON_REG, sled->slot_cfg.ec_index);
 		break;
 	}
 
-	return 0;
+	/* Always a full state, it replaces whatever is still waiting for the EC */
+	return qnap8528_ec_slot_submit(&sled->ec_slot, xfers, n, true);
 }
 
 static int qnap8528_led_slot_blink(struct led_classdev *cdev, unsigned long *delay_on, unsigned long *delay_off)
 {
 	struct qnap8528_slot_led *sled = container_of(cdev, struct qnap8528_slot_led, led_cdev);
+	struct qnap8528_ec_xfer xfers[3];
+	int n = 0;
 
 	/* HW blink acceptable range: measured at ~121ms and ~108ms for green/(red/amber), assuming a rate of 110 with a tolerance of ~25% */
 	if (!(*delay_on == 0 && *delay_off == 0) && (*delay_on < 80 || *delay_on > 140 || *delay_off < 80 || *delay_off > 140))
@@ -659,15 +1825,16 @@ static int qnap8528_led_slot_blink(struct led_classdev *cdev, unsigned long *del
 
 	sled->is_hw_blink = true;
 
-	if ((sled->led_cdev.brightness == 2) && sled->slot_cfg->has_locate) {
-		qnap8528_ec_write(EC_LED_DISK_ACTIVE_OFF_REG, sled->slot_cfg->ec_index);
-		qnap8528_ec_write(EC_LED_DISK_LOCATE_ON_REG, sled->slot_cfg->ec_index);
-		return 0;
-	} else if (sled->slot_cfg->has_active) {
-		qnap8528_ec_write(EC_LED_DISK_LOCATE_OFF_REG, sled->slot_cfg->ec_index);
-		qnap8528_ec_write(EC_LED_DISK_PRESENT_ON_REG, sled->slot_cfg->ec_index);
-		qnap8528_ec_write(EC_LED_DISK_ACTIVE_ON_REG, sled->slot_cfg->ec_index);
-		return 0;
+	if ((sled->led_cdev.brightness == 2) && sled->slot_cfg.has_locate) {
+		xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_ACTIVE_OFF_REG, sled->slot_cfg.ec_index);
+		xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_LOCATE_ON_REG, sled->slot_cfg.ec_index);
+		/* Builds on the last state set, so it goes after anything still waiting */
+		return qnap8528_ec_slot_submit(&sled->ec_slot, xfers, n, false);
+	} else if (sled->slot_cfg.has_active) {
+		xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_LOCATE_OFF_REG, sled->slot_cfg.ec_index);
+		xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_PRESENT_ON_REG, sled->slot_cfg.ec_index);
+		xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(EC_LED_DISK_ACTIVE_ON_REG, sled->slot_cfg.ec_index);
+		return qnap8528_ec_slot_submit(&sled->ec_slot, xfers, n, false);
 	}
 
 	sled->is_hw_blink = false;
@@ -676,46 +1843,26 @@ static int qnap8528_led_slot_blink(struct led_classdev *cdev, unsigned long *del
 
 static int qnap8528_led_panel_brightness_set(struct led_classdev *cdev, enum led_brightness brightness)
 {
-	int ret = -EINVAL;
-	u8 tmp;
+	/* The brightness is latched by setting the 0x245 flags, so always write them */
+	struct qnap8528_ec_xfer xfers[] = {
+		QNAP8528_EC_XFER_WRITE(0x243, brightness),
+		QNAP8528_EC_XFER_WRITE_BITS(0x245, 0x10, 0x10),
+		QNAP8528_EC_XFER_WRITE(0x246, brightness),
+		QNAP8528_EC_XFER_WRITE_BITS(0x245, 0xef, 0xef),
+	};
 
 	/* Always preserve the panel brightness, no matter the param */
 	if ((cdev->flags & LED_UNREGISTERING))
 		return 0;
 
-	ret = qnap8528_ec_write(0x243, brightness);
-	if (ret)
-		return ret;
-
-	ret = qnap8528_ec_read(0x245, &tmp);
-	if (ret)
-		return ret;
-	tmp |= 0x10;
-
-	ret = qnap8528_ec_write(0x245, tmp);
-	if (ret)
-		return ret;
-
-	ret = qnap8528_ec_write(0x246, brightness);
-	if (ret)
-		return ret;
-
-	ret = qnap8528_ec_read(0x245, &tmp);
-	if (ret)
-		return ret;
-	tmp |= 0xef;
-
-	ret = qnap8528_ec_write(0x245, tmp);
-	if (ret)
-		return ret;
-
-	return ret;
+	return qnap8528_ec_slot_submit(&container_of(cdev, struct qnap8528_system_led, cdev)->ec_slot,
+				       xfers, ARRAY_SIZE(xfers), true);
 }
 
 static int qnap8528_register_leds(struct device *dev)
 {
 	int i, ret;
-	struct qnap8528_slot_config *slots;
+	const struct qnap8528_slot_run *run;
 	struct qnap8528_slot_led *sled;
 	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
 
@@ -725,6 +1872,9 @@ static int qnap8528_register_leds(struct device *dev)
 		data->led_status.cdev.max_brightness = 2;
 		data->led_status.cdev.brightness_set_blocking = qnap8528_led_status_set;
 		data->led_status.cdev.blink_set = qnap8528_blink_sw_only ? NULL : qnap8528_led_status_blink;
+		ret = qnap8528_ec_slot_init(dev, &data->led_status.ec_slot);
+		if (ret)
+			return ret;
 		devm_led_classdev_register(dev, &data->led_status.cdev);
 		ret = qnap8528_blink_sw_only ? 0 : device_create_file(data->led_status.cdev.dev, &dev_attr_blink_bicolor);
 		if (ret)
@@ -736,6 +1886,9 @@ static int qnap8528_register_leds(struct device *dev)
 		data->led_usb.cdev.max_brightness = 1;
 		data->led_usb.cdev.brightness_set_blocking = qnap8528_led_usb_set;
 		data->led_usb.cdev.blink_set = qnap8528_blink_sw_only ? NULL : qnap8528_led_usb_blink;
+		ret = qnap8528_ec_slot_init(dev, &data->led_usb.ec_slot);
+		if (ret)
+			return ret;
 		devm_led_classdev_register(dev, &data->led_usb.cdev);
 	}
 
@@ -743,6 +1896,9 @@ static int qnap8528_register_leds(struct device *dev)
 		data->led_ident.cdev.name = DRVNAME "::ident";
 		data->led_ident.cdev.max_brightness = 1;
 		data->led_ident.cdev.brightness_set_blocking = qnap8528_led_ident_set;
+		ret = qnap8528_ec_slot_init(dev, &data->led_ident.ec_slot);
+		if (ret)
+			return ret;
 		devm_led_classdev_register(dev, &data->led_ident.cdev);
 	}
 
@@ -750,6 +1906,9 @@ static int qnap8528_register_leds(struct device *dev)
 		data->led_jbod.cdev.name = DRVNAME "::jbod";
 		data->led_jbod.cdev.max_brightness = 1;
 		data->led_jbod.cdev.brightness_set_blocking = qnap8528_led_jbod_set;
+		ret = qnap8528_ec_slot_init(dev, &data->led_jbod.ec_slot);
+		if (ret)
+			return ret;
 		devm_led_classdev_register(dev, &data->led_jbod.cdev);
 	}
 
@@ -757,6 +1916,9 @@ static int qnap8528_register_leds(struct device *dev)
 		data->led_10g.cdev.name = DRVNAME "::10GbE";
 		data->led_10g.cdev.max_brightness = 1;
 		data->led_10g.cdev.brightness_set_blocking = qnap8528_led_10g_set;
+		ret = qnap8528_ec_slot_init(dev, &data->led_10g.ec_slot);
+		if (ret)
+			return ret;
 		devm_led_classdev_register(dev, &data->led_10g.cdev);
 	}
 
@@ -764,27 +1926,46 @@ static int qnap8528_register_leds(struct device *dev)
 		data->led_brightness.cdev.name = DRVNAME "::panel_brightness";
 		data->led_brightness.cdev.max_brightness = 100;
 		data->led_brightness.cdev.brightness_set_blocking = qnap8528_led_panel_brightness_set;
+		ret = qnap8528_ec_slot_init(dev, &data->led_brightness.ec_slot);
+		if (ret)
+			return ret;
 		devm_led_classdev_register(dev, &data->led_brightness.cdev);
 	}
 
-	if (data->config->slots) {
-		slots = data->config->slots;
-		for (i = 0; slots[i].name; i++) {
-			/* If there is not least 1 static LED, why bother? */
-			if (!(slots[i].has_present | slots[i].has_error))
-				continue;
+	for (run = data->config->slots; run && run->count; run++) {
+		/* If there is not least 1 static LED, why bother? */
+		if (!(run->has_present | run->has_error))
+			continue;
 
+		for (i = 0; i < run->count; i++) {
 			sled = devm_kzalloc(dev, sizeof(*sled), GFP_KERNEL);
 			if (!sled)
 				return -ENOMEM;
-			sled->slot_cfg = &slots[i];
-			sled->led_cdev.name = devm_kasprintf(dev, GFP_KERNEL, DRVNAME "::%s", slots[i].name);
+
+			/* Expand the run into this slot's own config */
+			if (*run->prefix)
+				sled->slot_cfg.name = devm_kasprintf(dev, GFP_KERNEL, "%s%d", run->prefix, run->first + i);
+			else
+				sled->slot_cfg.name = "";
+			if (!sled->slot_cfg.name)
+				return -ENOMEM;
+			sled->slot_cfg.ec_index = run->ec_index + i;
+			sled->slot_cfg.has_present = run->has_present;
+			sled->slot_cfg.has_active = run->has_active;
+			sled->slot_cfg.has_error = run->has_error;
+			sled->slot_cfg.has_locate = run->has_locate;
+			sled->slot_cfg.has_power_ctrl = run->has_power_ctrl;
+
+			sled->led_cdev.name = devm_kasprintf(dev, GFP_KERNEL, DRVNAME "::%s", sled->slot_cfg.name);
 			if (!sled->led_cdev.name)
 				return -ENOMEM;
 			sled->led_cdev.max_brightness = 2;
 			sled->led_cdev.brightness_set_blocking = qnap8528_led_slot_set;
-			sled->led_cdev.blink_set = ((slots[i].has_active || slots[i].has_locate) && !qnap8528_blink_sw_only) ? qnap8528_led_slot_blink : NULL;
+			sled->led_cdev.blink_set = ((run->has_active || run->has_locate) && !qnap8528_blink_sw_only) ? qnap8528_led_slot_blink : NULL;
 			sled->pdev = dev;
+			ret = qnap8528_ec_slot_init(dev, &sled->ec_slot);
+			if (ret)
+				return ret;
 			devm_led_classdev_register(dev, &sled->led_cdev);
 		}
 	}
@@ -792,108 +1973,51 @@ static int qnap8528_register_leds(struct device *dev)
 	return 0;
 }
 
-/* Keeping this just in case we need it later on */
-
-/**
- *
- *static int qnap8528_fan_status_get(unsigned int fan)
- *{
- *	u16 reg;
- *	u8 value;
- *
- *	if (fan >=0 && fan <= 5)
- *		reg = 0x242;
- *	else if (fan >= 6 && fan <= 7)
- *		reg = 0x244;
- *	else if (fan >= 0x14 && fan <= 0x19)
- *		reg = 0x259;
- *	else if (fan >= 0x1e && fan <= 0x23)
- *		reg = 0x25a;
- *	else
- *		return -EINVAL;
- *
- *	if (qnap8528_ec_read(reg, &value))
- *		return -EBUSY;
- *
- *	if (fan >=0 && fan <= 5)
- *		return ((value >> (fan & 0x1f)) & 1) == 0 ? -ENODEV : 0;
- *	if (fan >= 6 && fan <= 7)
- *		return ((value >> ((fan - 0x06) & 0x1f)) & 1) == 0 ? -ENODEV : 0;
- *	if (fan >= 0x14 && fan <= 0x19)
- *		return ((value >> ((fan - 0x14) & 0x1f)) & 1) == 0 ? -ENODEV : 0;
- *	if (fan >= 0x1e && fan <= 0x23)
- *		return ((value >> ((fan - 0x1e) & 0x1f)) & 1) == 0 ? -ENODEV : 0;
- *
- *	return -EINVAL;
- * }
- */
-
-static int qnap8528_fan_rpm_get(unsigned int fan)
+static int qnap8528_fan_rpm_regs(unsigned int fan, u16 *reg_a, u16 *reg_b)
 {
-	u8 tmp;
-	u16 value, reg_a, reg_b;
-	int ret;
-
 	if (fan >= 0 && fan <= 5) {
-		reg_a = (fan + 0x312) * 2;
-		reg_b = (fan * 2) + 0x625;
+		*reg_a = (fan + 0x312) * 2;
+		*reg_b = (fan * 2) + 0x625;
 	} else if (fan == 6 || fan == 7) {
-		reg_a = (fan + 0x30a) * 2;
-		reg_b = ((fan - 6) * 2) + 0x621;
+		*reg_a = (fan + 0x30a) * 2;
+		*reg_b = ((fan - 6) * 2) + 0x621;
 	} else if (fan == 0x0a) {
-		reg_a = 0x65b;
-		reg_b = 0x65a;
+		*reg_a = 0x65b;
+		*reg_b = 0x65a;
 	} else if (fan == 0x0b) {
-		reg_a = 0x65e;
-		reg_b = 0x65d;
+		*reg_a = 0x65e;
+		*reg_b = 0x65d;
 	} else if (fan >= 0x14 && fan <= 0x19) {
-		reg_a = (fan + 0x30e) * 2;
-		reg_b = ((fan - 0x14) * 2) + 0x645;
+		*reg_a = (fan + 0x30e) * 2;
+		*reg_b = ((fan - 0x14) * 2) + 0x645;
 	} else if (fan >= 0x1e && fan <= 0x23) {
-		reg_a = (fan + 0x2f8) * 2;
-		reg_b = ((fan - 0x1e) * 2) + 0x62d;
+		*reg_a = (fan + 0x2f8) * 2;
+		*reg_b = ((fan - 0x1e) * 2) + 0x62d;
 	} else {
 		return -EINVAL;
 	}
 
-	ret = qnap8528_ec_read(reg_a, &tmp);
-	if (ret)
-		return ret;
-	value = tmp << 8;
-
-	ret = qnap8528_ec_read(reg_b, &tmp);
-	if (ret)
-		return ret;
-	return value | tmp;
+	return 0;
 }
 
-static int qnap8528_fan_pwm_get(unsigned int fan)
+static const struct qnap8528_fan_bank *qnap8528_fan_bank_get(unsigned int fan)
 {
-	u16 reg;
-	u8 value;
-	int ret;
+	int i;
 
-	if (fan >= 0 && fan <= 5)
-		reg = 0x22e;
-	else if (fan == 6 || fan == 7)
-		reg = 0x24b;
-	else if (fan >= 0x14 && fan <= 0x19)
-		reg = 0x22f;
-	else if (fan >= 0x1e && fan <= 0x23)
-		reg = 0x23b;
-	else
-		return -EINVAL;
+	for (i = 0; i < QNAP8528_HWMON_PWM_BANKS; i++) {
+		if (fan >= qnap8528_fan_banks[i].first &&
+		    fan < qnap8528_fan_banks[i].first + qnap8528_fan_banks[i].count)
+			return &qnap8528_fan_banks[i];
+	}
 
-	ret = qnap8528_ec_read(reg, &value);
-	if (ret)
-		return ret;
-	return (value * 0x100 - value) / 100;
+	return NULL;
 }
 
-static int qnap8528_fan_pwm_set(unsigned int fan, u8 value)
+static int qnap8528_fan_pwm_set(struct qnap8528_dev_data *data, unsigned int fan, u8 value)
 {
+	const struct qnap8528_fan_bank *bank = qnap8528_fan_bank_get(fan);
+	struct qnap8528_ec_xfer xfers[2];
 	u16 reg_a, reg_b;
-	int ret;
 
 	if (value > 255)
 		value = 255;
@@ -916,21 +2040,113 @@ static int qnap8528_fan_pwm_set(unsigned int fan, u8 value)
 		return -EINVAL;
 	}
 
-	ret = qnap8528_ec_write(reg_a, 0x10);
-	if (ret)
-		return ret;
+	/* Nobody needs to wait for the EC to take the new duty cycle, only the last one matters */
+	xfers[0] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(reg_a, 0x10);
+	xfers[1] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_WRITE(reg_b, value);
+	return qnap8528_ec_slot_submit(&data->fan_pwm[bank - qnap8528_fan_banks], xfers, ARRAY_SIZE(xfers), true);
+}
+
+/*
+ * Detect the fans in a single EC transfer. A fan counts when its status bit is
+ * set, its bank PWM is a valid percentage and its RPM is in a sane range, the
+ * RPM alone is not enough as absent fans do not always read as 0xffff.
+ */
+static int qnap8528_fan_enumerate(struct qnap8528_dev_data *data)
+{
+	struct qnap8528_ec_xfer xfers[QNAP8528_FAN_ENUM_XFERS];
+	const struct qnap8528_fan_bank *bank;
+	int bank_xfer[QNAP8528_HWMON_PWM_BANKS];
+	u16 reg_a, reg_b, rpm;
+	int i, j, n = 0, found = 0;
+	int ret;
+
+	for (i = 0; i < QNAP8528_HWMON_PWM_BANKS; i++) {
+		bank = &qnap8528_fan_banks[i];
+		bank_xfer[i] = n;
+		xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_READ(bank->status_reg);
+		xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_READ(bank->pwm_reg);
+		for (j = 0; j < bank->count; j++) {
+			qnap8528_fan_rpm_regs(bank->first + j, &reg_a, &reg_b);
+			xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_READ(reg_a);
+			xfers[n++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_READ_TIED(reg_b);
+		}
+	}
 
-	ret = qnap8528_ec_write(reg_b, value);
+	ret = qnap8528_ec_transfer(xfers, n);
 	if (ret)
 		return ret;
 
-	return 0;
+	for (i = 0; i < QNAP8528_HWMON_PWM_BANKS; i++) {
+		bank = &qnap8528_fan_banks[i];
+		n = bank_xfer[i];
+		if (xfers[n + 1].val > QNAP8528_FAN_PWM_MAX)
+			continue;
+
+		for (j = 0; j < bank->count; j++) {
+			rpm = (xfers[n + 2 + j * 2].val << 8) | xfers[n + 3 + j * 2].val;
+			if (!(xfers[n].val & BIT(j)) || !rpm || rpm > QNAP8528_FAN_RPM_MAX)
+				continue;
+
+			/* Same 1 based numbering as the model fan lists */
+			data->fans_found[found++] = bank->first + j + 1;
+		}
+	}
+	data->fans_found[found] = 0;
+
+	return found;
 }
 
-static int qnap8528_temperature_get(unsigned int sensor)
+/*
+ * Enumerating holds the EC for a while, so it runs after probe and the hwmon
+ * device is registered once the fans are known.
+ */
+static void qnap8528_fan_enum_work(struct work_struct *work)
+{
+	struct qnap8528_dev_data *data = container_of(work, struct qnap8528_dev_data, fan_enum);
+	struct device *hwmon_dev;
+	int ret, fans;
+
+	for (fans = 0; data->config->fans[fans]; fans++)
+		;
+
+	ret = qnap8528_fan_enumerate(data);
+	if (ret > 0) {
+		data->fans = data->fans_found;
+		pr_info("Enumerated %d fans, model %s lists %d", ret, data->config->name, fans);
+	} else {
+		pr_warn("Fan enumeration failed (%d), using the fans of model %s", ret, data->config->name);
+	}
+
+	ret = qnap8528_hwmon_setup(data);
+	if (ret) {
+		pr_err("Failed to scan the hwmon sensors (%d)", ret);
+		return;
+	}
+
+	hwmon_dev = hwmon_device_register_with_info(data->dev, DRVNAME, data, &data->hm_chip, NULL);
+	if (IS_ERR(hwmon_dev)) {
+		pr_err("Failed to register hwmon device (%ld)", PTR_ERR(hwmon_dev));
+		return;
+	}
+
+	data->hwmon_dev = hwmon_dev;
+	if (qnap8528_hwmon_sampler_start(data))
+		pr_warn("Failed to start the hwmon sampler, sensor reads will fail");
+	pr_info("Hwmon device registered");
+}
+
+static void qnap8528_fan_enum_cancel(void *data)
+{
+	struct qnap8528_dev_data *dev_data = data;
+
+	cancel_work_sync(&dev_data->fan_enum);
+	qnap8528_hwmon_sampler_stop(dev_data);
+	if (dev_data->hwmon_dev)
+		hwmon_device_unregister(dev_data->hwmon_dev);
+}
+
+static u16 qnap8528_temperature_reg(unsigned int sensor)
 {
-	u8 value;
-	int ret;
 	u16 reg = 0;
 
 	if (sensor == 0 || sensor == 1)				/* CPU temp only if CPU_TEMP_UNIT == "EC" else ??? */
@@ -944,19 +2160,15 @@ static int qnap8528_temperature_get(unsigned int sensor)
 	else if (sensor >= 0xf && sensor <= 0x26)	/* Env temp unit */
 		reg = 0x5f7 + sensor;
 
-
-	ret = reg ? qnap8528_ec_read(reg, &value) : -EBUSY;
-	if (ret)
-		return ret;
-
-	return (value < 128) && (value > 0) ? value : -ENODEV;
+	return reg;
 }
 
 static void qnap8528_input_poll(struct input_dev *input)
 {
-	u8 val = 0;
+	struct qnap8528_dev_data *data = input_get_drvdata(input);
+	unsigned int val = 0;
 
-	if (qnap8528_ec_read(QNAP8528_BUTTON_INPUT_REG, &val))
+	if (regmap_read(data->regmap, QNAP8528_BUTTON_INPUT_REG, &val))
 		return;
 
 	input_event(input, EV_KEY, BTN_0, !!(val & QNAP8528_INPUT_BTN_CHASSIS));
@@ -978,6 +2190,7 @@ static int qnap8528_register_inputs(struct device *dev)
 	data->input_dev->dev.parent = dev;
 	data->input_dev->phys = DRVNAME "/input0";
 	data->input_dev->id.bustype = BUS_HOST;
+	input_set_drvdata(data->input_dev, data);
 
 	input_set_capability(data->input_dev, EV_KEY,  BTN_0);
 	input_set_capability(data->input_dev, EV_KEY,  BTN_1);
@@ -998,125 +2211,494 @@ static int qnap8528_register_inputs(struct device *dev)
 
 static umode_t qnap8528_hwmon_is_visible(const void *data, enum hwmon_sensor_types type, u32 attr, int channel)
 {
-	u8 val;
-	int i;
-	umode_t mode = 0;
-	struct qnap8528_dev_data *dev_data = (struct qnap8528_dev_data *)data;
+	const struct qnap8528_dev_data *dev_data = data;
 
 	switch (type) {
+	case hwmon_chip:
+		return attr == hwmon_chip_update_interval ? 0644 : 0;
 	case hwmon_temp:
-		val = qnap8528_temperature_get(channel);
-		mode = ((val > 0) && (val < 128)) ? 0444 : 0;
-		break;
+		return test_bit(channel, dev_data->hm_temp_present) ? 0444 : 0;
 	case hwmon_fan:
-		channel += 1;
-		if (!dev_data->config->fans)
-			break;
-
-		for (i = 0; dev_data->config->fans[i]; i++) {
-			if (dev_data->config->fans[i] == channel)
-				mode = 0444;
-		}
-		break;
+		return test_bit(channel, dev_data->hm_fan_present) ? 0444 : 0;
 	case hwmon_pwm:
-		channel += 1;
-		if (!dev_data->config->fans)
-			break;
-
-		for (i = 0; dev_data->config->fans[i]; i++) {
-			if (dev_data->config->fans[i] == channel) {
-				if (channel >= 0 && channel <= 5) {
-					if (!dev_data->hm_pwm_channels[0]) {
-						dev_data->hm_pwm_channels[0] = true;
-						mode = 0644;
-						break;
-					}
-				}
-
-				if (channel == 6 || channel == 7) {
-					if (!dev_data->hm_pwm_channels[1]) {
-						dev_data->hm_pwm_channels[1] = true;
-						mode = 0644;
-						break;
-					}
-				}
-
-				if (channel >= 0x14 && channel <= 0x19) {
-					if (!dev_data->hm_pwm_channels[2]) {
-						dev_data->hm_pwm_channels[2] = true;
-						mode = 0644;
-						break;
-					}
-				}
-
-				if (channel >= 0x1e && channel <= 0x23) {
-					if (!dev_data->hm_pwm_channels[3]) {
-						dev_data->hm_pwm_channels[3] = true;
-						mode = 0644;
-						break;
-					}
-				}
-			}
-		}
+		return test_bit(channel, dev_data->hm_pwm_present) ? 0644 : 0;
 	default:
+		return 0;
 	}
-	return mode;
 }
 
 static int qnap8528_hwmon_read(struct device *dev, enum hwmon_sensor_types type, u32 attr, int channel, long *val)
 {
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	struct qnap8528_hwmon_snapshot *snap = &data->hm_snapshot;
+	int ret;
+
+	if (type == hwmon_chip) {
+		if (attr != hwmon_chip_update_interval)
+			return -ENOTSUPP;
+		*val = READ_ONCE(data->hm_interval_ms);
+		return 0;
+	}
+
+	/* The lock is held across sweeps, a wedged EC must not leave readers unkillable */
+	ret = mutex_lock_killable(&data->hm_lock);
+	if (ret)
+		return ret;
+
+	/* Do not fail a read that comes in before the sampler had its first go */
+	if (!snap->valid)
+		qnap8528_hwmon_sweep(data);
+
+	ret = snap->error;
+	if (ret)
+		goto qnap8528_hwmon_read_unlock;
+
 	switch (type) {
 	case hwmon_temp:
-		*val = qnap8528_temperature_get(channel) * 1000;
-		return 0;
+		if (snap->temp[channel] > 0 && snap->temp[channel] < 128)
+			*val = snap->temp[channel] * 1000;
+		else
+			ret = -ENODATA;
+		break;
 	case hwmon_fan:
-		*val = qnap8528_fan_rpm_get(channel);
-		return 0;
+		*val = snap->fan[channel];
+		break;
 	case hwmon_pwm:
-		*val = qnap8528_fan_pwm_get(channel);
-		return 0;
+		*val = snap->pwm[channel];
+		break;
 	default:
+		ret = -ENOTSUPP;
 	}
-	return -ENOTSUPP;
+
+qnap8528_hwmon_read_unlock:
+	mutex_unlock(&data->hm_lock);
+	return ret;
 }
 
 static int qnap8528_hwmon_write(struct device *dev, enum hwmon_sensor_types type, u32 attr, int channel, long val)
 {
-	if (type == hwmon_pwm)
-		return qnap8528_fan_pwm_set(channel, (val > 255) ? 255 : val);
-	return -ENOTSUPP;
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	int ret;
+
+	if (type == hwmon_chip && attr == hwmon_chip_update_interval) {
+		ret = mutex_lock_killable(&data->hm_lock);
+		if (ret)
+			return ret;
+		WRITE_ONCE(data->hm_interval_ms, clamp_val(val, QNAP8528_HWMON_INTERVAL_MIN_MS,
+							   QNAP8528_HWMON_INTERVAL_MAX_MS));
+		if (data->hm_running)
+			mod_delayed_work(system_wq, &data->hm_sampler, msecs_to_jiffies(data->hm_interval_ms));
+		mutex_unlock(&data->hm_lock);
+		return 0;
+	}
+
+	if (type != hwmon_pwm)
+		return -ENOTSUPP;
+
+	ret = qnap8528_fan_pwm_set(data, channel, clamp_val(val, 0, 255));
+	if (ret)
+		return ret;
+
+	/* Queued behind the write, the sweep reads back what the EC actually took */
+	ret = mutex_lock_killable(&data->hm_lock);
+	if (ret)
+		return ret;
+	if (data->hm_running)
+		mod_delayed_work(system_wq, &data->hm_sampler, 0);
+	mutex_unlock(&data->hm_lock);
+	return 0;
+}
+
+/*
+ * Find the channels to register with a single EC transfer over every known
+ * temperature register, a sensor is there if it reads between 0 and 128 (not
+ * including). Fans come from the model (or enumeration) and each PWM bank is
+ * controlled through its lowest numbered fan.
+ */
+static int qnap8528_hwmon_scan(struct qnap8528_dev_data *data)
+{
+	struct qnap8528_ec_xfer xfers[QNAP8528_HWMON_MAX_CHANNELS + 1];
+	const struct qnap8528_fan_bank *bank;
+	u16 reg_a, reg_b;
+	int i, ch, count = 0;
+	int ret;
+
+	bitmap_zero(data->hm_temp_present, QNAP8528_HWMON_MAX_CHANNELS + 1);
+	bitmap_zero(data->hm_fan_present, QNAP8528_HWMON_MAX_CHANNELS + 1);
+	bitmap_zero(data->hm_pwm_present, QNAP8528_HWMON_MAX_CHANNELS + 1);
+
+	for (ch = 0; ch <= QNAP8528_HWMON_MAX_CHANNELS; ch++) {
+		reg_a = qnap8528_temperature_reg(ch);
+		if (reg_a)
+			xfers[count++] = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_READ(reg_a);
+	}
+
+	ret = qnap8528_ec_transfer(xfers, count);
+	if (ret)
+		return ret;
+
+	for (ch = 0, i = 0; ch <= QNAP8528_HWMON_MAX_CHANNELS; ch++) {
+		if (!qnap8528_temperature_reg(ch))
+			continue;
+		if (xfers[i].val > 0 && xfers[i].val < 128)
+			set_bit(ch, data->hm_temp_present);
+		i++;
+	}
+
+	/* Fan lists are 1 based, hwmon fan channels are the EC fan index */
+	for (i = 0; data->fans && data->fans[i]; i++) {
+		ch = data->fans[i] - 1;
+		if (ch > QNAP8528_HWMON_MAX_CHANNELS || qnap8528_fan_rpm_regs(ch, &reg_a, &reg_b))
+			continue;
+		set_bit(ch, data->hm_fan_present);
+	}
+
+	for (i = 0; i < QNAP8528_HWMON_PWM_BANKS; i++) {
+		bank = &qnap8528_fan_banks[i];
+		ch = find_next_bit(data->hm_fan_present, bank->first + bank->count, bank->first);
+		if (ch < bank->first + bank->count)
+			set_bit(ch, data->hm_pwm_present);
+	}
+
+	pr_info("Found %d temperature sensors, %d fans and %d PWM channels",
+		bitmap_weight(data->hm_temp_present, QNAP8528_HWMON_MAX_CHANNELS + 1),
+		bitmap_weight(data->hm_fan_present, QNAP8528_HWMON_MAX_CHANNELS + 1),
+		bitmap_weight(data->hm_pwm_present, QNAP8528_HWMON_MAX_CHANNELS + 1));
+	return 0;
+}
+
+/*
+ * hwmon numbers channels by their position in the config array, so the array
+ * runs up to the last channel found to keep the sensor numbers stable, the
+ * channels missing in between are hidden by is_visible.
+ */
+static int qnap8528_hwmon_add_info(struct qnap8528_dev_data *data, enum hwmon_sensor_types type, u32 flags,
+				   const unsigned long *present)
+{
+	struct hwmon_channel_info *info;
+	u32 *config;
+	int ch, last = -1;
+
+	for_each_set_bit(ch, present, QNAP8528_HWMON_MAX_CHANNELS + 1)
+		last = ch;
+	if (last < 0)
+		return 0;
+
+	/* Zero filled, the extra entry terminates the array */
+	config = devm_kcalloc(data->dev, last + 2, sizeof(*config), GFP_KERNEL);
+	if (!config)
+		return -ENOMEM;
+	for (ch = 0; ch <= last; ch++)
+		config[ch] = flags;
+
+	for (ch = 0; data->hm_info[ch]; ch++)
+		;
+	info = &data->hm_chan[ch];
+	info->type = type;
+	info->config = config;
+	data->hm_info[ch] = info;
+	return 0;
+}
+
+static int qnap8528_hwmon_setup(struct qnap8528_dev_data *data)
+{
+	int ret;
+
+	ret = qnap8528_hwmon_scan(data);
+	if (ret)
+		return ret;
+
+	memset(data->hm_info, 0, sizeof(data->hm_info));
+	data->hm_info[0] = &qnap8528_hwmon_chip_chan_info;
+
+	ret = qnap8528_hwmon_add_info(data, hwmon_temp, HWMON_T_INPUT, data->hm_temp_present);
+	if (!ret)
+		ret = qnap8528_hwmon_add_info(data, hwmon_fan, HWMON_F_INPUT, data->hm_fan_present);
+	if (!ret)
+		ret = qnap8528_hwmon_add_info(data, hwmon_pwm, HWMON_PWM_INPUT, data->hm_pwm_present);
+	if (ret)
+		return ret;
+
+	data->hm_chip.ops = &qnap8528_hwmon_ops;
+	data->hm_chip.info = data->hm_info;
+	return 0;
+}
+
+/*
+ * Refresh every present channel with a single EC transfer, so any number of
+ * readers cost one sweep per update interval. Called with hm_lock held.
+ */
+static void qnap8528_hwmon_sweep(struct qnap8528_dev_data *data)
+{
+	struct qnap8528_hwmon_snapshot *snap = &data->hm_snapshot;
+	struct qnap8528_ec_xfer *xfer = data->hm_xfers;
+	int ch;
+
+	if (!data->hm_xfer_count)
+		return;
+
+	snap->error = qnap8528_ec_transfer(data->hm_xfers, data->hm_xfer_count);
+	if (snap->error)
+		return;
+
+	for_each_set_bit(ch, data->hm_temp_present, QNAP8528_HWMON_MAX_CHANNELS + 1)
+		snap->temp[ch] = (xfer++)->val;
+	for_each_set_bit(ch, data->hm_fan_present, QNAP8528_HWMON_MAX_CHANNELS + 1) {
+		snap->fan[ch] = (xfer[0].val << 8) | xfer[1].val;
+		xfer += 2;
+	}
+	for_each_set_bit(ch, data->hm_pwm_present, QNAP8528_HWMON_MAX_CHANNELS + 1) {
+		snap->pwm[ch] = (xfer->val * 0x100 - xfer->val) / 100;
+		xfer++;
+	}
+
+	snap->valid = true;
+}
+
+static void qnap8528_hwmon_sampler_work(struct work_struct *work)
+{
+	struct qnap8528_dev_data *data = container_of(to_delayed_work(work), struct qnap8528_dev_data, hm_sampler);
+
+	mutex_lock(&data->hm_lock);
+	qnap8528_hwmon_sweep(data);
+	if (data->hm_running)
+		schedule_delayed_work(&data->hm_sampler, msecs_to_jiffies(data->hm_interval_ms));
+	mutex_unlock(&data->hm_lock);
+}
+
+/* Build the sweep transfer from the channels found by the presence scan */
+static int qnap8528_hwmon_sampler_start(struct qnap8528_dev_data *data)
+{
+	struct qnap8528_ec_xfer *xfer;
+	u16 reg_a, reg_b;
+	int ch, count;
+
+	count = bitmap_weight(data->hm_temp_present, QNAP8528_HWMON_MAX_CHANNELS + 1) +
+		bitmap_weight(data->hm_fan_present, QNAP8528_HWMON_MAX_CHANNELS + 1) * 2 +
+		bitmap_weight(data->hm_pwm_present, QNAP8528_HWMON_MAX_CHANNELS + 1);
+	if (!count)
+		return 0;
+
+	xfer = devm_kcalloc(data->dev, count, sizeof(*xfer), GFP_KERNEL);
+	if (!xfer)
+		return -ENOMEM;
+
+	mutex_lock(&data->hm_lock);
+	data->hm_xfers = xfer;
+	data->hm_xfer_count = count;
+
+	for_each_set_bit(ch, data->hm_temp_present, QNAP8528_HWMON_MAX_CHANNELS + 1)
+		*xfer++ = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_READ(qnap8528_temperature_reg(ch));
+	for_each_set_bit(ch, data->hm_fan_present, QNAP8528_HWMON_MAX_CHANNELS + 1) {
+		qnap8528_fan_rpm_regs(ch, &reg_a, &reg_b);
+		*xfer++ = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_READ(reg_a);
+		*xfer++ = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_READ_TIED(reg_b);
+	}
+	for_each_set_bit(ch, data->hm_pwm_present, QNAP8528_HWMON_MAX_CHANNELS + 1)
+		*xfer++ = (struct qnap8528_ec_xfer)QNAP8528_EC_XFER_READ(qnap8528_fan_bank_get(ch)->pwm_reg);
+
+	data->hm_running = true;
+	schedule_delayed_work(&data->hm_sampler, 0);
+	mutex_unlock(&data->hm_lock);
+	return 0;
+}
+
+/* Nothing can re-arm the sampler once hm_running is clear, hwmon may still be registered */
+static void qnap8528_hwmon_sampler_stop(void *data)
+{
+	struct qnap8528_dev_data *dev_data = data;
+
+	mutex_lock(&dev_data->hm_lock);
+	dev_data->hm_running = false;
+	mutex_unlock(&dev_data->hm_lock);
+
+	cancel_delayed_work_sync(&dev_data->hm_sampler);
 }
 
 static int qnap8528_register_hwmon(struct device *dev)
 {
-	int i;
+	int i, ret;
 	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
 
-	for (i = 0; i < QNAP8528_HWMON_MAX_CHANNELS + 1; i++) {
-		qnap8528_hwmon_temp_config[i] = HWMON_T_INPUT;
-		qnap8528_hwmon_fan_config[i] = HWMON_F_INPUT;
-		qnap8528_hwmon_pwm_config[i] = HWMON_PWM_INPUT;
+	for (i = 0; i < QNAP8528_HWMON_PWM_BANKS; i++) {
+		ret = qnap8528_ec_slot_init(dev, &data->fan_pwm[i]);
+		if (ret)
+			return ret;
+	}
+
+	mutex_init(&data->hm_lock);
+	data->hm_interval_ms = QNAP8528_HWMON_INTERVAL_MS;
+	INIT_DELAYED_WORK(&data->hm_sampler, qnap8528_hwmon_sampler_work);
+
+	data->fans = data->config->fans;
+	if (qnap8528_fan_enumerate_param) {
+		INIT_WORK(&data->fan_enum, qnap8528_fan_enum_work);
+		ret = devm_add_action_or_reset(dev, qnap8528_fan_enum_cancel, data);
+		if (ret)
+			return ret;
+		schedule_work(&data->fan_enum);
+		return 0;
 	}
 
-	for (i = 0; i < QNAP8528_HWMON_PWM_BANKS; i++)
-		data->hm_pwm_channels[i] = false;
+	ret = qnap8528_hwmon_setup(data);
+	if (ret)
+		return ret;
 
-	data->hwmon_dev = devm_hwmon_device_register_with_info(dev, DRVNAME, data, &qnap8528_hwmon_chip_info, NULL);
+	data->hwmon_dev = devm_hwmon_device_register_with_info(dev, DRVNAME, data, &data->hm_chip, NULL);
 	if (IS_ERR(data->hwmon_dev))
 		return PTR_ERR(data->hwmon_dev);
 
+	ret = devm_add_action_or_reset(dev, qnap8528_hwmon_sampler_stop, data);
+	if (ret)
+		return ret;
+
+	ret = qnap8528_hwmon_sampler_start(data);
+	if (ret)
+		return ret;
+
 	pr_info("Hwmon device registered");
 	return 0;
 }
 
-static struct qnap8528_config *qnap8528_find_config(void)
+static bool qnap8528_config_match(const struct qnap8528_config *config, const char *mb_model, const char *bp_model)
+{
+	if (!strnlen(config->mb_model, 32) || !strnlen(config->bp_model, 32))
+		return false;
+
+	return strstr(mb_model, config->mb_model) && strstr(bp_model, config->bp_model);
+}
+
+static const struct qnap8528_config *__init qnap8528_find_config_name(const char *name)
+{
+	int i;
+
+	for (i = 0; qnap8528_configs[i].name; i++) {
+		if (!strcasecmp(qnap8528_configs[i].name, name))
+			return &qnap8528_configs[i];
+	}
+
+	return NULL;
+}
+
+/* QNAP firmware fills the DMI product name with the model name on most units */
+static const struct qnap8528_config *__init qnap8528_find_config_dmi(void)
+{
+	const char *vendor = dmi_get_system_info(DMI_SYS_VENDOR);
+	const char *product = dmi_get_system_info(DMI_PRODUCT_NAME);
+
+	if (!vendor || !product || !strstr(vendor, "QNAP"))
+		return NULL;
+
+	return qnap8528_find_config_name(product);
+}
+
+/*
+ * A model picked by name or DMI is double checked against the VPD model codes
+ * once probe is done, so a wrong guess is reported without holding up boot.
+ */
+static void qnap8528_config_check_work(struct work_struct *work)
+{
+	struct qnap8528_dev_data *data = container_of(work, struct qnap8528_dev_data, config_check);
+	char mb_model[QNAP8528_VPD_ENTRY_MAX + 1] = {0};
+	char bp_model[QNAP8528_VPD_ENTRY_MAX + 1] = {0};
+
+	if (qnap8528_vpd_read(data, QNAP8528_VPD_MB_MODEL, mb_model) ||
+	    qnap8528_vpd_read(data, QNAP8528_VPD_BP_MODEL, bp_model)) {
+		pr_warn("Could not read VPD model codes to verify model %s", data->config->name);
+		return;
+	}
+
+	if (!qnap8528_config_match(data->config, mb_model, bp_model))
+		pr_warn("VPD model codes MB=%s BP=%s do not match model %s (expected MB=%s BP=%s)",
+			mb_model, bp_model, data->config->name, data->config->mb_model, data->config->bp_model);
+}
+
+static void qnap8528_config_check_cancel(void *data)
+{
+	cancel_work_sync(&((struct qnap8528_dev_data *)data)->config_check);
+}
+
+/*
+ * The model table is init only, copy the matched config with its fans and
+ * slots into device managed memory so it outlives the table.
+ */
+static const struct qnap8528_config *__init qnap8528_config_copy(struct device *dev, const struct qnap8528_config *config)
+{
+	struct qnap8528_config *copy;
+	int fans, slots;
+
+	for (fans = 0; config->fans[fans]; fans++)
+		;
+	for (slots = 0; config->slots[slots].count; slots++)
+		;
+
+	copy = devm_kmemdup(dev, config, sizeof(*config), GFP_KERNEL);
+	if (!copy)
+		return NULL;
+
+	copy->fans = devm_kmemdup(dev, config->fans, (fans + 1) * sizeof(*config->fans), GFP_KERNEL);
+	copy->slots = devm_kmemdup(dev, config->slots, (slots + 1) * sizeof(*config->slots), GFP_KERNEL);
+	if (!copy->fans || !copy->slots)
+		return NULL;
+
+	return copy;
+}
+
+static const struct qnap8528_config *__init qnap8528_find_config(struct device *dev)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	const struct qnap8528_config *config = NULL;
+	bool check = true;
+
+	if (qnap8528_model) {
+		config = qnap8528_find_config_name(qnap8528_model);
+		if (config)
+			pr_info("Using configuration for model %s set by module parameter", config->name);
+		else
+			pr_warn("Unknown model %s set by module parameter, detecting model", qnap8528_model);
+	}
+
+	if (!config) {
+		config = qnap8528_find_config_dmi();
+		if (config)
+			pr_info("DMI match found, model is %s", config->name);
+	}
+
+	/* Both of these read the VPD codes, the model config firmware goes first */
+	if (!config) {
+		/* Already device managed and matched against the VPD codes */
+		data->config = qnap8528_find_config_fw(dev);
+		if (data->config)
+			return data->config;
+
+		config = qnap8528_find_config_vpd(data);
+		check = false;
+	}
+
+	if (!config)
+		return NULL;
+
+	/* The check runs against data->config, so it has to be set before it is queued */
+	data->config = qnap8528_config_copy(dev, config);
+	if (!data->config || !check)
+		return data->config;
+
+	INIT_WORK(&data->config_check, qnap8528_config_check_work);
+	if (devm_add_action_or_reset(dev, qnap8528_config_check_cancel, data))
+		return NULL;
+	schedule_work(&data->config_check);
+
+	return data->config;
+}
+
+static const struct qnap8528_config *__init qnap8528_find_config_vpd(struct qnap8528_dev_data *data)
 {
 	int i;
-	char mb_model[QNAP8528_VPD_ENTRY_MAX + 1];
-	char bp_model[QNAP8528_VPD_ENTRY_MAX + 1];
+	char mb_model[QNAP8528_VPD_ENTRY_MAX + 1] = {0};
+	char bp_model[QNAP8528_VPD_ENTRY_MAX + 1] = {0};
 
-	qnap8528_vpd_attr_show(NULL, &(struct qnap8528_device_attribute){.vpd_entry = QNAP8528_VPD_MB_MODEL}, mb_model);
-	qnap8528_vpd_attr_show(NULL, &(struct qnap8528_device_attribute){.vpd_entry = QNAP8528_VPD_BP_MODEL}, bp_model);
+	qnap8528_vpd_read(data, QNAP8528_VPD_MB_MODEL, mb_model);
+	qnap8528_vpd_read(data, QNAP8528_VPD_BP_MODEL, bp_model);
 
 	if (!strnlen(mb_model, 32) || !strnlen(bp_model, 32))
 		return 0;
@@ -1124,20 +2706,158 @@ static struct qnap8528_config *qnap8528_find_config(void)
 	pr_info("Searching configs for a match with MB=%s BP=%s", mb_model, bp_model);
 
 	for (i = 0; qnap8528_configs[i].mb_model && qnap8528_configs[i].bp_model; i++) {
-		if (!strnlen(qnap8528_configs[i].mb_model, 32) || !strnlen(qnap8528_configs[i].bp_model, 32))
-			continue;
-
-		if (strstr(mb_model, qnap8528_configs[i].mb_model) && strstr(bp_model, qnap8528_configs[i].bp_model)) {
+		if (qnap8528_config_match(&qnap8528_configs[i], mb_model, bp_model)) {
 			pr_info("Model codes match found, model is %s", qnap8528_configs[i].name);
 			/* CR: Add here sanity check for features */
 			return &qnap8528_configs[i];
 		}
 	}
+
 	pr_err("Could not find configuration for device, please report this issue");
 	return 0;
 }
 
-static int qnap8528_probe(struct platform_device *pdev)
+static bool __init qnap8528_fw_model_valid(const struct qnap8528_fw_model *model, const struct qnap8528_fw_run *runs)
+{
+	int i;
+
+	if (!strnlen(model->name, sizeof(model->name)) || model->name[sizeof(model->name) - 1] ||
+	    !strnlen(model->mb_model, sizeof(model->mb_model)) || model->mb_model[sizeof(model->mb_model) - 1] ||
+	    !strnlen(model->bp_model, sizeof(model->bp_model)) || model->bp_model[sizeof(model->bp_model) - 1])
+		return false;
+
+	if (le32_to_cpu(model->features) & ~QNAP8528_FW_FEATURES || model->timing > QNAP8528_FW_TIMING_ENE)
+		return false;
+
+	if (!memchr(model->fans, 0, sizeof(model->fans)))
+		return false;
+
+	for (i = 0; i < model->run_count; i++) {
+		if (runs[i].prefix[sizeof(runs[i].prefix) - 1] || !runs[i].count ||
+		    runs[i].flags & ~QNAP8528_FW_RUN_FLAGS)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Build a config from a model record. Only the matched record is kept, the
+ * strings and fans of the config point into that copy.
+ */
+static const struct qnap8528_config *__init qnap8528_fw_model_config(struct device *dev, const struct qnap8528_fw_model *model,
+								     const struct qnap8528_fw_run *runs)
+{
+	size_t record = sizeof(*model) + model->run_count * sizeof(*runs);
+	struct qnap8528_config *config;
+	struct qnap8528_slot_run *slots;
+	u32 features = le32_to_cpu(model->features);
+	int i;
+
+	/*
+	 * One allocation holds the config, its slot runs (the zeroed last run
+	 * terminates them) and a copy of the matched record the strings point
+	 * into, the rest of the blob is released once probe has matched.
+	 */
+	config = devm_kzalloc(dev, sizeof(*config) + (model->run_count + 1) * sizeof(*slots) + record, GFP_KERNEL);
+	if (!config)
+		return NULL;
+	slots = (struct qnap8528_slot_run *)(config + 1);
+	model = memcpy(slots + model->run_count + 1, model, record);
+	runs = (const struct qnap8528_fw_run *)(model + 1);
+
+	config->name = model->name;
+	config->mb_model = model->mb_model;
+	config->bp_model = model->bp_model;
+	config->fans = model->fans;
+	config->slots = slots;
+	if (model->timing == QNAP8528_FW_TIMING_ENE)
+		config->timing = (struct qnap8528_ec_timing)QNAP8528_EC_TIMING_ENE;
+
+	config->features.pwr_recovery = !!(features & BIT(0));
+	config->features.eup_mode = !!(features & BIT(1));
+	config->features.led_brightness = !!(features & BIT(2));
+	config->features.led_status = !!(features & BIT(3));
+	config->features.led_10g = !!(features & BIT(4));
+	config->features.led_usb = !!(features & BIT(5));
+	config->features.led_jbod = !!(features & BIT(6));
+	config->features.led_ident = !!(features & BIT(7));
+	config->features.enc_serial_mb = !!(features & BIT(8));
+
+	for (i = 0; i < model->run_count; i++) {
+		slots[i].prefix = runs[i].prefix;
+		slots[i].first = runs[i].first;
+		slots[i].count = runs[i].count;
+		slots[i].ec_index = runs[i].ec_index;
+		slots[i].has_present = !!(runs[i].flags & BIT(0));
+		slots[i].has_active = !!(runs[i].flags & BIT(1));
+		slots[i].has_error = !!(runs[i].flags & BIT(2));
+		slots[i].has_locate = !!(runs[i].flags & BIT(3));
+		slots[i].has_power_ctrl = !!(runs[i].flags & BIT(4));
+	}
+
+	return config;
+}
+
+/*
+ * Look for a model matching the VPD codes in the optional model config
+ * firmware, so new models and fixed layouts do not need a rebuilt module.
+ */
+static const struct qnap8528_config *__init qnap8528_find_config_fw(struct device *dev)
+{
+	struct qnap8528_dev_data *data = dev_get_drvdata(dev);
+	char mb_model[QNAP8528_VPD_ENTRY_MAX + 1] = {0};
+	char bp_model[QNAP8528_VPD_ENTRY_MAX + 1] = {0};
+	const struct qnap8528_config *config = NULL;
+	const struct qnap8528_fw_header *hdr;
+	const struct qnap8528_fw_model *model;
+	const struct qnap8528_fw_run *runs;
+	const struct firmware *fw;
+	const u8 *pos, *end;
+	int i;
+
+	/* Direct load, a missing file is the normal case and must not stall probe */
+	if (request_firmware_direct(&fw, QNAP8528_FW_NAME, dev))
+		return NULL;
+
+	hdr = (const struct qnap8528_fw_header *)fw->data;
+	if (fw->size < sizeof(*hdr) || le32_to_cpu(hdr->magic) != QNAP8528_FW_MAGIC ||
+	    le16_to_cpu(hdr->version) != QNAP8528_FW_VERSION) {
+		pr_warn("Ignoring %s, not a version %d model config", QNAP8528_FW_NAME, QNAP8528_FW_VERSION);
+		goto qnap8528_find_config_fw_release;
+	}
+
+	if (qnap8528_vpd_read(data, QNAP8528_VPD_MB_MODEL, mb_model) ||
+	    qnap8528_vpd_read(data, QNAP8528_VPD_BP_MODEL, bp_model))
+		goto qnap8528_find_config_fw_release;
+
+	pos = fw->data + sizeof(*hdr);
+	end = fw->data + fw->size;
+	for (i = 0; i < le16_to_cpu(hdr->count); i++) {
+		model = (const struct qnap8528_fw_model *)pos;
+		runs = (const struct qnap8528_fw_run *)(model + 1);
+		if (end - pos < sizeof(*model) || (end - (const u8 *)runs) / sizeof(*runs) < model->run_count ||
+		    !qnap8528_fw_model_valid(model, runs)) {
+			pr_warn("Ignoring %s, model record %d is malformed", QNAP8528_FW_NAME, i);
+			goto qnap8528_find_config_fw_release;
+		}
+		pos = (const u8 *)(runs + model->run_count);
+
+		if (!strstr(mb_model, model->mb_model) || !strstr(bp_model, model->bp_model))
+			continue;
+
+		config = qnap8528_fw_model_config(dev, model, runs);
+		if (config)
+			pr_info("Model codes match found in %s, model is %s", QNAP8528_FW_NAME, config->name);
+		break;
+	}
+
+qnap8528_find_config_fw_release:
+	release_firmware(fw);
+	return config;
+}
+
+static int __init qnap8528_probe(struct platform_device *pdev)
 {
 	int ret = 0;
 	struct qnap8528_dev_data *data;
@@ -1159,11 +2879,19 @@ static int qnap8528_probe(struct platform_device *pdev)
 		return -ENOMEM;
 
 	dev_set_drvdata(&pdev->dev, data);
+	data->dev = &pdev->dev;
+	mutex_init(&data->vpd_lock);
+
+	data->regmap = devm_regmap_init(&pdev->dev, &qnap8528_regmap_bus, data, &qnap8528_regmap_config);
+	if (IS_ERR(data->regmap))
+		return PTR_ERR(data->regmap);
 
-	data->config = qnap8528_find_config();
+	data->config = qnap8528_find_config(&pdev->dev);
 	if (!data->config)
 		return -ENOTSUPP;
 
+	qnap8528_ec_calibrate(data->config);
+
 	ret = qnap8528_register_inputs(&pdev->dev);
 	if (ret)
 		return ret;
@@ -1176,6 +2904,10 @@ static int qnap8528_probe(struct platform_device *pdev)
 	if (ret)
 		return ret;
 
+	ret = qnap8528_register_debugfs(&pdev->dev);
+	if (ret)
+		return ret;
+
 	return 0;
 }
 
@@ -1184,6 +2916,7 @@ static void __exit qnap8528_exit(void)
 	if (qnap8528_pdevice)
 		platform_device_unregister(qnap8528_pdevice);
 	platform_driver_unregister(&qnap8528_pdriver);
+	qnap8528_ec_queue_destroy();
 	pr_info("Module unloaded");
 }
 
@@ -1191,21 +2924,25 @@ static int __init qnap8528_init(void)
 {
 	int ret = 0;
 
-	/* Create a platform driver and a (pseudo) platform device to probe the driver */
-	ret = platform_driver_register(&qnap8528_pdriver);
+	ret = qnap8528_ec_queue_init();
 	if (ret)
 		goto qnap8528_init_ret;
 
+	/* Create a (pseudo) platform device and probe the driver against it */
 	qnap8528_pdevice = platform_device_register_simple(DRVNAME, PLATFORM_DEVID_NONE, qnap8528_resources, ARRAY_SIZE(qnap8528_resources));
 	if (IS_ERR(qnap8528_pdevice)) {
 		ret = PTR_ERR(qnap8528_pdevice);
-		goto qnap8528_init_driver_unregister;
+		goto qnap8528_init_queue_destroy;
 	}
 
-	/* If the driver failed to probe, no point of having the module loaded */
-	if (!qnap8528_pdevice->dev.driver) {
+	/*
+	 * If the driver failed to probe, no point of having the module loaded.
+	 * The probe runs only here and the driver cannot be rebound later, as
+	 * it uses init only data.
+	 */
+	ret = platform_driver_probe(&qnap8528_pdriver, qnap8528_probe);
+	if (ret) {
 		pr_err("qnap8528 device driver failed to probe, unloading");
-		ret = -ENODEV;
 		goto qnap8528_init_device_unregister;
 	}
 
@@ -1213,8 +2950,8 @@ static int __init qnap8528_init(void)
 
 qnap8528_init_device_unregister:
 	platform_device_unregister(qnap8528_pdevice);
-qnap8528_init_driver_unregister:
-	platform_driver_unregister(&qnap8528_pdriver);
+qnap8528_init_queue_destroy:
+	qnap8528_ec_queue_destroy();
 qnap8528_init_ret:
 	return ret;
 }
@@ -11,8 +11,21 @@
 #define DRVNAME "qnap8528"
 
 #define QNAP8528_EC_CHIP_ID			0x8528
-#define QNAP8528_EC_UDELAY          1000
-#define QNAP8528_EC_MAX_RETRY       5000
+#define QNAP8528_EC_SPIN_US         50
+#define QNAP8528_EC_SPIN_MIN_US     10
+#define QNAP8528_EC_SPIN_MAX_US     100
+#define QNAP8528_EC_SLEEP_MIN_US    20
+#define QNAP8528_EC_SLEEP_MAX_US    100
+#define QNAP8528_EC_SLEEP_MS        1000
+#define QNAP8528_EC_CALIBRATE_ROUNDS 16
+#define QNAP8528_EC_TIMEOUT_MS      5000
+#define QNAP8528_EC_PROBE_MS        1000
+#define QNAP8528_EC_STATUS_OBF      BIT(0)
+#define QNAP8528_EC_STATUS_IBF      BIT(1)
+#define QNAP8528_EC_MAX_REG         0x7fff
+#define QNAP8528_EC_HIST_BUCKETS    25
+#define QNAP8528_EC_STARVE_MS       100
+#define QNAP8528_EC_SLOT_XFERS      12
 #define QNAP8528_EC_CMD_PORT        0x6c
 #define QNAP8528_EC_DAT_PORT        0x68
 
@@ -22,6 +35,12 @@
 #define QNAP8528_PWR_RECOVERY_REG	0x16
 #define QNAP8528_EUP_SUPPORT_REG	0x101
 #define QNAP8528_EUP_MODE_REG		0x121
+#define QNAP8528_VPD_REG_FIRST		0x56
+#define QNAP8528_VPD_REG_LAST		0x62
+#define QNAP8528_FAN_REG_FIRST		0x220
+#define QNAP8528_FAN_REG_LAST		0x25a
+#define QNAP8528_SENSOR_REG_FIRST	0x600
+#define QNAP8528_SENSOR_REG_LAST	0x65e
 
 /**
  * EC VPD entries
@@ -45,7 +64,7 @@
  *	Unknown	table			type		length		offset
  *				0: Main PCB		0 - str
  *				1: Backplane	1 - num
- *				2/3: Not used	2 - date
+ *				2/3: Unknown	2 - date
  *	Example:
  *	VPD entry 0x0c1000cb = table 3, offset 203, length 16 and type 0
  *	0000		11				00			00010000	0000000011001011
@@ -54,10 +73,19 @@
  *Notes:
  *	Tables 2 and 3 may be used for network and redandent power VPD
  *	as there are hints to it in hal_daemon/libLinux_hal. Maybe for the 3rd model
- *	code?
+ *	code? They are only read when an entry in them is asked for, and are
+ *	exposed raw as vpd/table2 and vpd/table3 for working that out.
  */
 
 #define QNAP8528_VPD_ENTRY_MAX      U8_MAX
+#define QNAP8528_VPD_TABLE_SIZE     512
+#define QNAP8528_VPD_TABLES         4
+#define QNAP8528_VPD_SETTLE_US      5000
+#define QNAP8528_VPD_QUERY_MAX      32
+#define QNAP8528_VPD_TABLE(entry)   (((entry) >> 0x1a) & 3)
+#define QNAP8528_VPD_TYPE(entry)    (((entry) >> 0x18) & 3)
+#define QNAP8528_VPD_LEN(entry)     (((entry) >> 0x10) & 0xff)
+#define QNAP8528_VPD_OFFSET(entry)  ((entry) & 0xffff)
 #define QNAP8528_VPD_ENC_SERIAL     0xdeadbeef
 #define QNAP8528_VPD_ENC_NICKNAME   0x001000d6
 #define QNAP8528_VPD_MB_MANUF       0x0010000f
@@ -98,8 +126,260 @@
 
 #define QNAP8528_HWMON_PWM_BANKS    4
 #define QNAP8528_HWMON_MAX_CHANNELS 38
+#define QNAP8528_HWMON_INFO_MAX     4   /* chip, temp, fan and pwm */
 
+/* Fan enumeration, one status and PWM register pair per bank, then both RPM halves per fan */
+#define QNAP8528_FAN_ENUM_MAX       20
+#define QNAP8528_FAN_ENUM_XFERS     (QNAP8528_HWMON_PWM_BANKS * 2 + QNAP8528_FAN_ENUM_MAX * 2)
+#define QNAP8528_FAN_PWM_MAX        100
+#define QNAP8528_FAN_RPM_MAX        20000
 
+/* hwmon sampler, every present channel is read in one transfer per update interval */
+#define QNAP8528_HWMON_INTERVAL_MS      2000
+#define QNAP8528_HWMON_INTERVAL_MIN_MS  250
+#define QNAP8528_HWMON_INTERVAL_MAX_MS  60000
+
+
+
+/*
+ * struct qnap8528_ec_xfer - Single register access within an EC transfer
+ *
+ * @reg                 EC register to access
+ * @val                 Value to write, or the value read back from the EC
+ * @mask                Bits of @val to apply for read-modify-write accesses
+ * @write               Write @val to the register instead of reading it
+ * @update              Read-modify-write the @mask bits of the register to @val
+ * @force               Write an updated register even when its value does not change
+ * @tied                Runs right after the previous access, the worker does not yield in between
+ */
+struct qnap8528_ec_xfer {
+	u16 reg;
+	u8 val;
+	u8 mask;
+	u8 write:1;
+	u8 update:1;
+	u8 force:1;
+	u8 tied:1;
+};
+
+#define QNAP8528_EC_XFER_READ(_reg)         { .reg = (_reg) }
+#define QNAP8528_EC_XFER_READ_TIED(_reg)    { .reg = (_reg), .tied = 1 }
+#define QNAP8528_EC_XFER_WRITE(_reg, _val)  { .reg = (_reg), .val = (_val), .write = 1 }
+#define QNAP8528_EC_XFER_UPDATE(_reg, _mask, _val)      { .reg = (_reg), .val = (_val), .mask = (_mask), .update = 1 }
+#define QNAP8528_EC_XFER_WRITE_BITS(_reg, _mask, _val)  { .reg = (_reg), .val = (_val), .mask = (_mask), .update = 1, .force = 1 }
+
+/*
+ * EC access classes, in order of priority
+ *
+ * @QNAP8528_EC_CLASS_INTERACTIVE   Buttons, LEDs, sysfs attributes, someone is waiting
+ * @QNAP8528_EC_CLASS_PERIODIC      hwmon sensor and fan reads
+ * @QNAP8528_EC_CLASS_BULK          Long VPD walks, yield between every byte
+ */
+enum qnap8528_ec_class {
+	QNAP8528_EC_CLASS_INTERACTIVE,
+	QNAP8528_EC_CLASS_PERIODIC,
+	QNAP8528_EC_CLASS_BULK,
+	QNAP8528_EC_CLASS_MAX
+};
+
+/*
+ * EC health, the circuit breaker state
+ *
+ * @QNAP8528_EC_HEALTH_OK           EC is responding, requests go through
+ * @QNAP8528_EC_HEALTH_TRIPPED      A transaction missed its deadline, requests fail with -EIO
+ * @QNAP8528_EC_HEALTH_PROBING      Background probe is checking if the EC recovered
+ */
+enum qnap8528_ec_health {
+	QNAP8528_EC_HEALTH_OK,
+	QNAP8528_EC_HEALTH_TRIPPED,
+	QNAP8528_EC_HEALTH_PROBING,
+};
+
+enum qnap8528_ec_stage {
+	QNAP8528_EC_STAGE_IBF_CLEAR,
+	QNAP8528_EC_STAGE_OBF_CLEAR,
+	QNAP8528_EC_STAGE_OBF_SET,
+	QNAP8528_EC_STAGE_MAX
+};
+
+enum qnap8528_ec_range {
+	QNAP8528_EC_RANGE_CTRL,
+	QNAP8528_EC_RANGE_VPD,
+	QNAP8528_EC_RANGE_FAN,
+	QNAP8528_EC_RANGE_INFO,
+	QNAP8528_EC_RANGE_SENSOR,
+	QNAP8528_EC_RANGE_OTHER,
+	QNAP8528_EC_RANGE_MAX
+};
+
+/*
+ * struct qnap8528_ec_stage_stats - Handshake wait statistics
+ *
+ * @calls               Number of waits for this handshake stage
+ * @retries             Total status polls that did not match
+ * @max_retries         Most polls a single wait needed
+ * @timeouts            Waits that gave up
+ */
+struct qnap8528_ec_stage_stats {
+	u64 calls;
+	u64 retries;
+	u64 max_retries;
+	u64 timeouts;
+};
+
+/*
+ * struct qnap8528_ec_req_stats - EC request latency statistics
+ *
+ * @count               Number of requests serviced
+ * @errors              Requests that failed
+ * @wait                log2 histogram (us) of time spent queued for the EC
+ * @hold                log2 histogram (us) of time the EC was held by the request
+ * @total               log2 histogram (us) of submit to completion time
+ */
+struct qnap8528_ec_req_stats {
+	u64 count;
+	u64 errors;
+	u64 wait[QNAP8528_EC_HIST_BUCKETS];
+	u64 hold[QNAP8528_EC_HIST_BUCKETS];
+	u64 total[QNAP8528_EC_HIST_BUCKETS];
+};
+
+/*
+ * struct qnap8528_ec_stats - EC transport statistics, exposed in debugfs
+ *
+ * @stages              Handshake wait statistics per stage
+ * @reqs                Request statistics by direction (read, write) and register range
+ */
+struct qnap8528_ec_stats {
+	struct qnap8528_ec_stage_stats stages[QNAP8528_EC_STAGE_MAX];
+	struct qnap8528_ec_req_stats reqs[2][QNAP8528_EC_RANGE_MAX];
+};
+
+/*
+ * struct qnap8528_ec_timing - EC handshake timing
+ *
+ * @spin_us             Time to busy-poll the status port before sleeping between polls
+ * @sleep_ms            Time to keep sleep-polling before giving up on a handshake stage
+ */
+struct qnap8528_ec_timing {
+	u32 spin_us;
+	u32 sleep_ms;
+};
+
+/*
+ * The ITE units answer within a few microseconds, the ENE based TS-464 family
+ * is much slower. The ENE profile is also used until the model is known.
+ */
+#define QNAP8528_EC_TIMING_DEFAULT  { .spin_us = QNAP8528_EC_SPIN_US, .sleep_ms = QNAP8528_EC_SLEEP_MS }
+#define QNAP8528_EC_TIMING_ENE      { .spin_us = 200, .sleep_ms = 5000 }
+
+/*
+ * struct qnap8528_ec_xact - Single EC read or write being driven by the worker
+ *
+ * @seq                 Sequence number of the request the transaction belongs to
+ * @command             EC register being accessed
+ * @data                Byte being written, 0 for reads
+ * @retries             Status polls retried so far by the transaction
+ * @start               Time the transaction started
+ * @deadline            Time by which all handshake stages must have completed
+ * @max_wait_ns         Longest single handshake stage wait in this transaction
+ */
+struct qnap8528_ec_xact {
+	u32 seq;
+	u16 command;
+	u8 data;
+	u32 retries;
+	ktime_t start;
+	ktime_t deadline;
+	u64 max_wait_ns;
+};
+
+/*
+ * struct qnap8528_ec_req - Request serviced by the EC worker
+ *
+ * @node                Entry in the EC queue pending list of its class
+ * @fn                  Function run by the worker with exclusive access to the EC
+ * @xfers               Transfers to run, for transfer requests
+ * @count               Number of entries in @xfers
+ * @pos                 Entries of @xfers already run, a long transfer yields to higher classes
+ * @status              Return value of @fn
+ * @class               Access class the request is queued in
+ * @seq                 Sequence number assigned on submission, for tracing
+ * @submitted           Time the request was queued
+ * @queued              Time the request was last put on its pending list, for the starvation guard
+ * @hold                Time spent running @fn, summed over every chunk of a request that yields
+ * @done                Completed once @fn has run, for synchronous requests
+ * @async               Nobody waits on the request, it belongs to @slot
+ * @slot                Coalescing slot of an asynchronous request
+ */
+struct qnap8528_ec_req {
+	struct list_head node;
+	int (*fn)(struct qnap8528_ec_req *req);
+	struct qnap8528_ec_xfer *xfers;
+	int count;
+	int pos;
+	int status;
+	enum qnap8528_ec_class class;
+	u32 seq;
+	ktime_t submitted;
+	ktime_t queued;
+	ktime_t hold;
+	struct completion done;
+	bool async;
+	struct qnap8528_ec_slot *slot;
+};
+
+/*
+ * struct qnap8528_ec_slot - Asynchronous write slot of a single LED or PWM bank
+ *
+ * Writes nobody waits for go through the slot of what they change, so at most
+ * one request per slot is ever queued and nothing is allocated per change. A
+ * new full state replaces the one still waiting, a slow EC only sees the latest.
+ *
+ * @req                 Request queued for the slot, runs @run
+ * @next                Writes waiting to be run, protected by the queue lock
+ * @next_count          Number of entries in @next
+ * @run                 Copy of @next taken by the worker when it picks up @req
+ * @queued              @req is on a pending list, protected by the queue lock
+ * @status              First error since the last submission, protected by the queue lock
+ */
+struct qnap8528_ec_slot {
+	struct qnap8528_ec_req req;
+	struct qnap8528_ec_xfer next[QNAP8528_EC_SLOT_XFERS];
+	int next_count;
+	struct qnap8528_ec_xfer run[QNAP8528_EC_SLOT_XFERS];
+	bool queued;
+	int status;
+};
+
+/*
+ * struct qnap8528_ec_queue - EC submission queue
+ *
+ * @lock                Protects @pending
+ * @pending             Requests waiting for the worker, one list per access class
+ * @work                The worker, the only context that drives the EC ports
+ * @wq                  Ordered workqueue running @work
+ * @seq                 Next request sequence number, protected by @lock
+ * @xact                Transaction in flight, only touched by the worker
+ * @health              Circuit breaker state
+ * @trips               Number of times the breaker tripped
+ * @recover             Background probe run while the breaker is tripped
+ * @timing              Handshake timing in effect, from the model profile and calibration
+ * @stopping            Module is unloading, new requests fail and the breaker stops probing
+ */
+struct qnap8528_ec_queue {
+	spinlock_t lock;
+	struct list_head pending[QNAP8528_EC_CLASS_MAX];
+	struct work_struct work;
+	struct workqueue_struct *wq;
+	u32 seq;
+	struct qnap8528_ec_xact xact;
+	enum qnap8528_ec_health health;
+	u32 trips;
+	struct delayed_work recover;
+	struct qnap8528_ec_timing timing;
+	bool stopping;
+};
 
 struct qnap8528_device_attribute {
 	struct attribute attr;
@@ -164,7 +444,30 @@ struct qnap8528_features {
  * *@has_power_ctrl     Flag if slot disk power can be toggled.
  */
 struct qnap8528_slot_config {
-	char *name;
+	const char *name;
+	u8 ec_index;
+	u8 has_present:1;
+	u8 has_active:1;
+	u8 has_error:1;
+	u8 has_locate:1;
+	u8 has_power_ctrl:1;
+};
+
+/*
+ * struct qnap8528_slot_run - Run of disk slots sharing the same features
+ *
+ * Expanded into one qnap8528_slot_config per slot when the LEDs are registered.
+ *
+ * @prefix              Slot name prefix (e.g. "hdd"), empty for unnamed slots
+ * @first               Number appended to the prefix for the first slot
+ * @count               Number of slots in the run, 0 terminates a run array
+ * @ec_index            EC control index of the first slot, the rest follow it
+ * @has_*               Same as in qnap8528_slot_config, for every slot in the run
+ */
+struct qnap8528_slot_run {
+	const char *prefix;
+	u8 first;
+	u8 count;
 	u8 ec_index;
 	u8 has_present:1;
 	u8 has_active:1;
@@ -181,35 +484,153 @@ struct qnap8528_slot_config {
  * @bp_code:            Backplain model code to match
  * @features:           qnap8528_features struct for available features on this model
  * @fans:               0 terminated arrray of fans indexes supported by this model
- * @slots:              qnap8528_slot_config struct for creating slot related LEDs and attributes
+ * @slots:              qnap8528_slot_run array for creating slot related LEDs and attributes
+ * @timing:             EC timing profile for this model, zero to use the default one
  */
 struct qnap8528_config {
-	char *name;
-	char *mb_model;
-	char *bp_model;
+	const char *name;
+	const char *mb_model;
+	const char *bp_model;
 	struct qnap8528_features features;
-	u8 *fans;
-	struct qnap8528_slot_config *slots;
+	const u8 *fans;
+	const struct qnap8528_slot_run *slots;
+	struct qnap8528_ec_timing timing;
+};
+
+/*
+ * Model config firmware
+ *
+ * A blob loaded with request_firmware() at probe carries extra or corrected
+ * model configs, a record whose MB/BP codes match the VPD takes precedence over
+ * the built in table. Layout, all values little endian:
+ *
+ *	struct qnap8528_fw_header       magic, format version and number of models
+ *	then per model:
+ *	struct qnap8528_fw_model        model record
+ *	struct qnap8528_fw_run          run_count slot runs
+ *
+ * Strings are NUL terminated inside their field. Feature bits follow the order of qnap8528_features and slot
+ * run flag bits the order of the has_* flags, both starting at bit 0. Timing
+ * is 0 for the default EC timing profile and 1 for the ENE one.
+ */
+#define QNAP8528_FW_NAME            "qnap8528_models.bin"
+#define QNAP8528_FW_MAGIC           0x46433851  /* "Q8CF" */
+#define QNAP8528_FW_VERSION         2
+#define QNAP8528_FW_MAX_FANS        16
+#define QNAP8528_FW_FEATURES        GENMASK(8, 0)
+#define QNAP8528_FW_RUN_FLAGS       GENMASK(4, 0)
+#define QNAP8528_FW_TIMING_ENE      1
+
+struct qnap8528_fw_header {
+	__le32 magic;
+	__le16 version;
+	__le16 count;
+} __packed;
+
+struct qnap8528_fw_model {
+	char name[32];
+	char mb_model[8];
+	char bp_model[8];
+	__le32 features;
+	u8 timing;
+	u8 run_count;
+	u8 reserved[2];
+	u8 fans[QNAP8528_FW_MAX_FANS];
+} __packed;
+
+struct qnap8528_fw_run {
+	char prefix[8];
+	u8 first;
+	u8 count;
+	u8 ec_index;
+	u8 flags;
+} __packed;
+
+/*
+ * struct qnap8528_fan_bank - Fans sharing a status and a PWM register
+ *
+ * @first               EC index of the first fan in the bank
+ * @count               Number of fans in the bank
+ * @status_reg          Fan status register, bit n set if fan first + n is present
+ * @pwm_reg             PWM duty cycle register of the bank, in percent
+ */
+struct qnap8528_fan_bank {
+	u8 first;
+	u8 count;
+	u16 status_reg;
+	u16 pwm_reg;
+};
+
+/*
+ * struct qnap8528_hwmon_snapshot - Last sensor sweep, served to hwmon reads
+ *
+ * @temp                Raw temperature of each temperature channel
+ * @fan                 Speed in RPM of each fan channel
+ * @pwm                 Duty cycle (0-255) of each PWM channel
+ * @error               Result of the last sweep, the values are stale if set
+ * @valid               At least one sweep completed
+ */
+struct qnap8528_hwmon_snapshot {
+	u8 temp[QNAP8528_HWMON_MAX_CHANNELS + 1];
+	u16 fan[QNAP8528_HWMON_MAX_CHANNELS + 1];
+	u8 pwm[QNAP8528_HWMON_MAX_CHANNELS + 1];
+	int error;
+	bool valid;
 };
 
 struct qnap8528_slot_led {
 	struct led_classdev led_cdev;
-	struct qnap8528_slot_config *slot_cfg;
+	struct qnap8528_slot_config slot_cfg;
 	struct device *pdev;
 	bool is_hw_blink;
+	struct qnap8528_ec_slot ec_slot;
 };
 
 struct qnap8528_system_led {
 	struct led_classdev cdev;
 	bool is_hw_blink;
+	struct qnap8528_ec_slot ec_slot;
 };
 
 struct qnap8528_dev_data {
-	struct qnap8528_config  *config;
-	bool hm_pwm_channels[QNAP8528_HWMON_PWM_BANKS];
+	struct device           *dev;
+	const struct qnap8528_config *config;
+	struct regmap           *regmap;
+	struct mutex            vpd_lock;
+	/* Snapshot of the VPD tables, each allocated and loaded on first access, protected by vpd_lock */
+	u8                      *vpd_tables[QNAP8528_VPD_TABLES];
+	unsigned long           vpd_valid;
+	/* Longest time seen for a VPD byte to change after moving the address, protected by vpd_lock */
+	unsigned int            vpd_settle_us;
+	/* Entries to decode on a read of vpd/query, one list per device shared by all users, protected by vpd_lock */
+	u32                     vpd_query[QNAP8528_VPD_QUERY_MAX];
+	int                     vpd_query_count;
+	struct work_struct      config_check;
+	/* Fans shown in hwmon, the model's list or the enumerated one, 0 terminated like config->fans */
+	const u8                *fans;
+	u8                      fans_found[QNAP8528_FAN_ENUM_MAX + 1];
+	struct work_struct      fan_enum;
+	struct qnap8528_ec_slot fan_pwm[QNAP8528_HWMON_PWM_BANKS];
+	/* Channels found by the presence scan, the only ones hwmon shows and the sampler refreshes */
+	DECLARE_BITMAP(hm_temp_present, QNAP8528_HWMON_MAX_CHANNELS + 1);
+	DECLARE_BITMAP(hm_fan_present, QNAP8528_HWMON_MAX_CHANNELS + 1);
+	DECLARE_BITMAP(hm_pwm_present, QNAP8528_HWMON_MAX_CHANNELS + 1);
+	/* Sweep transfer, its result and the sampler state, protected by hm_lock */
+	struct mutex            hm_lock;
+	struct qnap8528_ec_xfer *hm_xfers;
+	int                     hm_xfer_count;
+	struct qnap8528_hwmon_snapshot hm_snapshot;
+	unsigned int            hm_interval_ms;
+	struct delayed_work     hm_sampler;
+	bool                    hm_running;
+	/* Channel info sized to the channels found, config arrays are device managed */
+	struct hwmon_channel_info hm_chan[QNAP8528_HWMON_INFO_MAX];
+	const struct hwmon_channel_info *hm_info[QNAP8528_HWMON_INFO_MAX + 1];
+	struct hwmon_chip_info  hm_chip;
 	/* Do I really need handles to all my devices?  */
 	struct input_dev	    *input_dev;
 	struct device           *hwmon_dev;
+	struct dentry           *debugfs;
 	struct qnap8528_system_led     led_status;
 	struct qnap8528_system_led     led_usb;
 	struct qnap8528_system_led     led_ident;
@@ -219,22 +640,74 @@ struct qnap8528_dev_data {
 };
 
 static int qnap8528_ec_hw_check(void);
+static int qnap8528_ec_wait_status(enum qnap8528_ec_stage stage, u8 mask, u8 value, bool drain);
 static int qnap8528_ec_wait_ibf_clear(void);
 static int qnap8528_ec_clear_obf(void);
 static int qnap8528_ec_wait_obf_set(void);
 static int qnap8528_ec_send_command(u16 command);
+static void __qnap8528_ec_xact_start(u16 command, u8 data);
+static int __qnap8528_ec_read(u16 command, u8 *data);
+static int __qnap8528_ec_write(u16 command, u8 data);
+static int __qnap8528_ec_update_bits(u16 command, u8 mask, u8 val, bool force);
+static int __qnap8528_ec_transfer(struct qnap8528_ec_xfer *xfers, int count);
+static struct qnap8528_ec_req *qnap8528_ec_queue_pop(u32 *seq, ktime_t *submitted);
+static bool qnap8528_ec_queue_preempt(enum qnap8528_ec_class class);
+static enum qnap8528_ec_range qnap8528_ec_reg_range(u16 reg);
+static void qnap8528_ec_hist_add(u64 *hist, ktime_t delta);
+static void qnap8528_ec_stats_account(struct qnap8528_ec_req *req, ktime_t submitted, ktime_t end);
+static void qnap8528_ec_queue_work(struct work_struct *work);
+static enum qnap8528_ec_class qnap8528_ec_req_class(struct qnap8528_ec_req *req);
+static void qnap8528_ec_submit(struct qnap8528_ec_req *req);
+static int qnap8528_ec_submit_wait(struct qnap8528_ec_req *req);
+static void qnap8528_ec_trip(void);
+static int qnap8528_ec_req_probe(struct qnap8528_ec_req *req);
+static int qnap8528_ec_req_calibrate(struct qnap8528_ec_req *req);
+static void qnap8528_ec_calibrate(const struct qnap8528_config *config);
+static void qnap8528_ec_recover_work(struct work_struct *work);
+static int qnap8528_ec_req_transfer(struct qnap8528_ec_req *req);
+static int qnap8528_ec_transfer(struct qnap8528_ec_xfer *xfers, int count);
+static int qnap8528_ec_slot_submit(struct qnap8528_ec_slot *slot, const struct qnap8528_ec_xfer *xfers, int count,
+				   bool replace);
+static void qnap8528_ec_slot_flush(void *data);
+static int qnap8528_ec_slot_init(struct device *dev, struct qnap8528_ec_slot *slot);
 static int qnap8528_ec_read(u16 command, u8 *data);
 static int qnap8528_ec_write(u16 command, u8 data);
+static int qnap8528_ec_update_bits(u16 command, u8 mask, u8 val);
+static int qnap8528_ec_write_async(struct qnap8528_ec_slot *slot, u16 command, u8 data);
+static int qnap8528_regmap_reg_read(void *context, unsigned int reg, unsigned int *val);
+static int qnap8528_regmap_reg_write(void *context, unsigned int reg, unsigned int val);
+static int qnap8528_regmap_reg_update_bits(void *context, unsigned int reg, unsigned int mask, unsigned int val);
+static void qnap8528_ec_stats_show_hist(struct seq_file *s, const char *name, const u64 *hist);
+static int qnap8528_ec_stats_show(struct seq_file *s, void *unused);
+static void qnap8528_debugfs_remove(void *dir);
+static int qnap8528_register_debugfs(struct device *dev);
+static int qnap8528_ec_queue_init(void);
+static void qnap8528_ec_queue_destroy(void);
 
 static umode_t qnap8528_ec_attr_check_visible(struct kobject *kobj, struct attribute *attr, int n);
 static ssize_t qnap8528_fw_version_attr_show(struct device *dev, struct device_attribute *attr, char *buf);
 static ssize_t qnap8528_cpld_version_attr_show(struct device *dev, struct device_attribute *attr, char *buf);
+static ssize_t qnap8528_breaker_state_attr_show(struct device *dev, struct device_attribute *attr, char *buf);
+static ssize_t qnap8528_breaker_trips_attr_show(struct device *dev, struct device_attribute *attr, char *buf);
 static ssize_t qnap8528_power_recovery_attr_show(struct device *dev, struct device_attribute *attr, char *buf);
 static ssize_t qnap8528_power_recovery_attr_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count);
 static ssize_t qnap8528_eup_mode_attr_show(struct device *dev, struct device_attribute *attr, char *buf);
 static ssize_t qnap8528_eup_mode_attr_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count);
+static int qnap8528_vpd_settle(struct qnap8528_dev_data *data, u16 reg, unsigned int stale, unsigned int *val);
+static int __qnap8528_vpd_fetch(struct qnap8528_dev_data *data, int table, u16 offs, u16 len, u8 *raw);
+static int qnap8528_vpd_read(struct qnap8528_dev_data *data, u32 entry, char *raw);
+static int qnap8528_vpd_snapshot(struct qnap8528_dev_data *data, int table);
+static int __qnap8528_vpd_lookup(struct qnap8528_dev_data *data, u32 entry, char *raw);
+static int qnap8528_vpd_lookup(struct qnap8528_dev_data *data, u32 entry, char *raw);
+static u32 qnap8528_vpd_resolve(struct qnap8528_dev_data *data, u32 entry);
+static ssize_t qnap8528_vpd_table_read(struct file *filp, struct kobject *kobj, struct bin_attribute *attr,
+				       char *buf, loff_t off, size_t count);
+static ssize_t qnap8528_vpd_refresh_store(struct device *dev, struct qnap8528_device_attribute *attr, const char *buf, size_t count);
 static ssize_t qnap8528_vpd_attr_show(struct device *dev, struct qnap8528_device_attribute *attr, char *buf);
-static ssize_t qnap8528_vpd_parse(int type, int size, char *raw, char *buf);
+static ssize_t qnap8528_vpd_query_store(struct device *dev, struct qnap8528_device_attribute *attr, const char *buf, size_t count);
+static ssize_t qnap8528_vpd_all_show(struct device *dev, struct qnap8528_device_attribute *attr, char *buf);
+static ssize_t qnap8528_vpd_query_show(struct device *dev, struct qnap8528_device_attribute *attr, char *buf);
+static ssize_t qnap8528_vpd_parse(int type, int size, char *raw, char *buf, size_t len);
 
 static ssize_t blink_bicolor_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count);
 static int qnap8528_led_status_set(struct led_classdev *cdev, enum led_brightness brightness);
@@ -245,11 +718,13 @@ static int qnap8528_led_slot_blink(struct led_classdev *cdev, unsigned long *del
 static int qnap8528_led_panel_brightness_set(struct led_classdev *cdev, enum led_brightness brightness);
 static int qnap8528_register_leds(struct device *dev);
 
-/* static int qnap8528_fan_status_get(unsigned int fan); */
-static int qnap8528_fan_rpm_get(unsigned int fan);
-static int qnap8528_fan_pwm_get(unsigned int fan);
-static int qnap8528_fan_pwm_set(unsigned int fan, u8 value);
-static int qnap8528_temperature_get(unsigned int sensor);
+static int qnap8528_fan_rpm_regs(unsigned int fan, u16 *reg_a, u16 *reg_b);
+static const struct qnap8528_fan_bank *qnap8528_fan_bank_get(unsigned int fan);
+static int qnap8528_fan_enumerate(struct qnap8528_dev_data *data);
+static void qnap8528_fan_enum_work(struct work_struct *work);
+static void qnap8528_fan_enum_cancel(void *data);
+static int qnap8528_fan_pwm_set(struct qnap8528_dev_data *data, unsigned int fan, u8 value);
+static u16 qnap8528_temperature_reg(unsigned int sensor);
 
 static void qnap8528_input_poll(struct input_dev *input);
 static int qnap8528_register_inputs(struct device *dev);
@@ -257,1851 +732,31 @@ static int qnap8528_register_inputs(struct device *dev);
 static umode_t qnap8528_hwmon_is_visible(const void *data, enum hwmon_sensor_types type, u32 attr, int channel);
 static int qnap8528_hwmon_read(struct device *dev, enum hwmon_sensor_types type, u32 attr, int channel, long *val);
 static int qnap8528_hwmon_write(struct device *dev, enum hwmon_sensor_types type, u32 attr, int channel, long val);
+static int qnap8528_hwmon_scan(struct qnap8528_dev_data *data);
+static int qnap8528_hwmon_add_info(struct qnap8528_dev_data *data, enum hwmon_sensor_types type, u32 flags,
+				   const unsigned long *present);
+static int qnap8528_hwmon_setup(struct qnap8528_dev_data *data);
+static void qnap8528_hwmon_sweep(struct qnap8528_dev_data *data);
+static void qnap8528_hwmon_sampler_work(struct work_struct *work);
+static int qnap8528_hwmon_sampler_start(struct qnap8528_dev_data *data);
+static void qnap8528_hwmon_sampler_stop(void *data);
 static int qnap8528_register_hwmon(struct device *dev);
 
-static struct qnap8528_config *qnap8528_find_config(void);
-static int qnap8528_probe(struct platform_device *pdev);
+static bool qnap8528_config_match(const struct qnap8528_config *config, const char *mb_model, const char *bp_model);
+static const struct qnap8528_config *__init qnap8528_find_config_name(const char *name);
+static const struct qnap8528_config *__init qnap8528_find_config_dmi(void);
+static void qnap8528_config_check_work(struct work_struct *work);
+static void qnap8528_config_check_cancel(void *data);
+static const struct qnap8528_config *__init qnap8528_config_copy(struct device *dev, const struct qnap8528_config *config);
+static const struct qnap8528_config *__init qnap8528_find_config_vpd(struct qnap8528_dev_data *data);
+static bool __init qnap8528_fw_model_valid(const struct qnap8528_fw_model *model, const struct qnap8528_fw_run *runs);
+static const struct qnap8528_config *__init qnap8528_fw_model_config(struct device *dev, const struct qnap8528_fw_model *model,
+								     const struct qnap8528_fw_run *runs);
+static const struct qnap8528_config *__init qnap8528_find_config_fw(struct device *dev);
+static const struct qnap8528_config *__init qnap8528_find_config(struct device *dev);
+static int __init qnap8528_probe(struct platform_device *pdev);
 static void __exit qnap8528_exit(void);
 static int __init qnap8528_init(void);
 
-static struct qnap8528_config qnap8528_configs[] = {
-		{
-		"TDS-2489FU", "Q0530", "Q0590",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 4, 5, 6, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "u2ssd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd13", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd14", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd15", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd16", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd17", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd18", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd19", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd20", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd21", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd22", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd23", .ec_index = 23, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd24", .ec_index = 24, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TDS-2489FU R2", "Q0531", "Q0590",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 4, 5, 6, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "u2ssd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd13", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd14", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd15", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd16", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd17", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd18", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd19", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd20", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd21", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd22", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd23", .ec_index = 23, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd24", .ec_index = 24, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TES-1685-SAS", "QY380", "QY390",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd3", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd4", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd5", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd6", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TES-1885U", "QX540", "QY270",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_10g        = 1,
-			.led_jbod       = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "ssd1", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd6", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TES-3085U", "QX541", "QY510",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_10g        = 1,
-			.led_jbod       = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "ssd1", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd6", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TNS-1083X", "Q0410", "Q0490",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TNS-C1083X", "Q0411", "Q0490",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1090FU", "Q09B0", "Q09I0",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 5, 4, 2, 1, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "u2ssd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd7", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd8", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd9", .ec_index = 9, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd10", .ec_index = 10, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1273AU", "Q0520", "Q05G0",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1273AU-RP", "Q0520", "Q0670",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1277XU", "QZ490", "QZ550",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1283XU", "QZ601", "Q00M0",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 6, 1, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1290FX", "Q09A0", "Q09C0",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_10g        = 1,
-			.led_usb        = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "u2ssd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd7", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd8", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd9", .ec_index = 9, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd10", .ec_index = 10, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd11", .ec_index = 11, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd12", .ec_index = 12, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1655", "Q07Z1", "Q08G0",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 13, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 14, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 15, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 16, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1673AU-RP", "Q0520", "Q0580",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1677XU", "QZ491", "QZ540",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd13", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd14", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd15", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd16", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1683XU", "QZ601", "Q0040",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 6, 1, 2, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd13", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd14", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd15", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd16", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1685", "QY380", "QY390",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd3", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd4", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd5", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd6", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1886XU", "Q0470", "Q04L0",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_10g        = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "ssd1", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 16, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 17, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd6", .ec_index = 18, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1886XU R2", "Q0B50", "Q0950",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "ssd1", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 16, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 17, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd6", .ec_index = 18, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-1887XU", "Q0840", "Q0950",
-		.features = {
-			.eup_mode       = 1,
-			.led_status     = 1,
-			.led_10g        = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "ssd1", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd6", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-2287XU", "Q0840", "Q08A0",
-		.features = {
-			.eup_mode       = 1,
-			.led_status     = 1,
-			.led_10g        = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "ssd1", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd6", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd13", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd14", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd15", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd16", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-2477XU", "QZ500", "Q0070",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd13", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd14", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd15", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd16", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd17", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd18", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd19", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd20", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd21", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd22", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd23", .ec_index = 23, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd24", .ec_index = 24, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-2483XU", "Q00V1", "Q00W0",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 6, 1, 2, 3, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd13", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd14", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd15", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd16", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd17", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd18", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd19", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd20", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd21", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd22", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd23", .ec_index = 23, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd24", .ec_index = 24, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-2490FU", "Q03X0", "Q04K0",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_10g        = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "u2ssd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd13", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd14", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd15", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd16", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd17", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd18", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd19", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd20", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd21", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd22", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd23", .ec_index = 23, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd24", .ec_index = 24, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-2888X", "Q00Q0", "Q00S0",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 3, 4, 21, 22, 31, 32, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "u2ssd1", .ec_index = 25, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd2", .ec_index = 26, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd3", .ec_index = 27, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "u2ssd4", .ec_index = 28, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd6", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd7", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd8", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd9", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd10", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd11", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd12", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd13", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd14", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd15", .ec_index = 23, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd16", .ec_index = 24, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-3087XU", "Q08H0", "Q08Z0",
-		.features = {
-			.eup_mode       = 1,
-			.led_status     = 1,
-			.led_10g        = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "ssd1", .ec_index = 30, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 29, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 28, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 27, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 26, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd6", .ec_index = 25, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd13", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd14", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd15", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd16", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd17", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd18", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd19", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd20", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd21", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd22", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd23", .ec_index = 23, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd24", .ec_index = 24, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-3088XU", "Q06X0", "Q06Y0",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_10g        = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "ssd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd13", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd14", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd15", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd16", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd17", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd18", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd19", .ec_index = 19, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd20", .ec_index = 20, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd21", .ec_index = 21, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd22", .ec_index = 22, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd23", .ec_index = 23, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd24", .ec_index = 24, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd25", .ec_index = 25, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd26", .ec_index = 26, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd27", .ec_index = 27, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd28", .ec_index = 28, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd29", .ec_index = 29, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd30", .ec_index = 30, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-473A", "Q07D0", "Q07N0",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-655X", "Q0CH0", "Q0CI0",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-673A", "Q07D0", "Q07M0",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-686", "Q05S0", "Q0660",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 8, 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-855EU", "Q0BT0", "Q0BU0",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-855X", "Q0CH0", "Q0CJ0",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-873A", "Q07D0", "Q07L0",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-873AEU", "Q0AK0", "Q0AO0",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-873AEU-RP", "Q0AK0", "Q0AO1",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-873AU", "Q0520", "Q05G1",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-873AU-RP", "Q0520", "Q0671",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-877XU", "QZ490", "QZ551",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-883XU", "QZ601", "Q00M1",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 6, 1, 4, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-886", "Q05S0", "Q0650",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 8, 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-973AX", "Q0711", "Q0760",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-977XU", "QZ480", "Q0060",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-983XU", "Q00I1", "Q00X0",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 6, 3, 2, 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd5", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-1275U", "SAP00", "SBO70",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 3, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-1288X", "Q05W0", "Q05K0",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-1675U", "SAP00", "SBO80",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 3, 2, 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd13", .ec_index = 13, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd14", .ec_index = 14, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd15", .ec_index = 15, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd16", .ec_index = 16, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-1688X", "Q05T0", "Q0630",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 3, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 17, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 18, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd1", .ec_index = 13, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd2", .ec_index = 14, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd3", .ec_index = 15, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "ssd4", .ec_index = 16, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd9", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd10", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd11", .ec_index = 11, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd12", .ec_index = 12, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-472X", "Q0420", "Q0180",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-472XT", "Q0120", "Q0180",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-474", "Q0BB0", "Q0BL0",
-		.features = {
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-672N", "Q0420", "Q0170",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-672X", "Q0121", "Q0170",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-672XT", "Q0120", "Q0170",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-674", "B6490", "Q0BK0",
-		.features = {
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-675", "Q08B0", "Q0890",
-		.features = {
-			.pwr_recovery   = 1,
-			.eup_mode       = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-872N", "Q0420", "Q0160",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-872X", "Q0121", "Q0160",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-872XT", "Q0120", "Q0160",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 8, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-874", "B6490", "Q0AA0",
-		.features = {
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-875U", "SAP00", "SBO60",
-		.features = {
-			.pwr_recovery   = 1,
-			.led_status     = 1,
-			.led_jbod       = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 3, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-H674T", "B6491", "Q0BK0",
-		.features = {
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-H674X", "B6492", "Q0BK0",
-		.features = {
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-H874T", "B6491", "Q0AA0",
-		.features = {
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TVS-H874X", "B6492", "Q0AA0",
-		.features = {
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 7, 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 9, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 10, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd5", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd6", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd7", .ec_index = 7, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd8", .ec_index = 8, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-464", "Q07R1", "Q08F0",
-		{
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-		},
-		.fans = (u8[]){ 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-464C", "SAQ93", "SBR00",
-		{
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-		},
-		.fans = (u8[]){ 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd1", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-464C2", "SAQ95", "SBR00",
-		{
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-		},
-		.fans = (u8[]){ 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd1", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-464T4", "Q0910", "Q08F0",
-		{
-			.led_brightness = 1,
-			.led_status     = 1,
-			.led_usb        = 1,
-		},
-		.fans = (u8[]){ 1, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "m2ssd1", .ec_index = 5, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "m2ssd2", .ec_index = 6, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd1", .ec_index = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{
-		"TS-464U", "Q08S0", "QY740",
-		{
-			.eup_mode       = 1,
-			.led_status     = 1,
-			.led_ident      = 1,
-		},
-		.fans = (u8[]){ 1, 2, 0},
-		.slots = (struct qnap8528_slot_config[]){
-			{ .name = "hdd1", .ec_index = 1, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd2", .ec_index = 2, .has_present = 1, .has_active = 1, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd3", .ec_index = 3, .has_error = 1, .has_locate = 1},
-			{ .name = "hdd4", .ec_index = 4, .has_error = 1, .has_locate = 1},
-			{ NULL }
-		}
-	},
-	{ NULL }
-};
+/* Model table, generated at build time from qnap8528_models.txt, init only */
+#include "qnap8528_models.h"
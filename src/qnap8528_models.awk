@@ -0,0 +1,183 @@
+# Generates qnap8528_models.h from qnap8528_models.txt
+#
+# Every model becomes one const struct qnap8528_config entry in
+# qnap8528_configs[]. Fan lists and slot run layouts are emitted once and shared
+# by all the models that use the same one, so identical layouts such as the
+# 8 bay TS-873A and TVS-874 cost a single array. Everything is __initconst,
+# probe copies the one matched config out before init memory is freed.
+#
+# Setting the models variable (-v models="TS-473A TS-873A") only generates the
+# listed models. Names are separated by spaces or commas, spaces inside a model
+# name are written as underscores (e.g. "TS-1886XU_R2").
+
+function fail(msg)
+{
+	printf("%s:%d: %s\n", FILENAME, FNR, msg) > "/dev/stderr"
+	err = 1
+	exit 1
+}
+
+function finish_model(    id, key)
+{
+	if (name == "")
+		return
+
+	if (mb == "" || bp == "")
+		fail("model " name " is missing its mb or bp code")
+
+	key = name
+	gsub(/ /, "_", key)
+	if (nwanted && !(key in wanted)) {
+		name = mb = bp = timing = features = fans = slots = ""
+		return
+	}
+	found[key] = 1
+
+	key = fans
+	if (!(key in fans_id)) {
+		id = nfans++
+		fans_id[key] = id
+		arrays = arrays sprintf("static const u8 qnap8528_fans_%d[] __initconst = { %s0 };\n\n", id, fans)
+	}
+	cfg_fans = fans_id[key]
+
+	key = slots
+	if (!(key in slots_id)) {
+		id = nslots++
+		slots_id[key] = id
+		arrays = arrays sprintf("static const struct qnap8528_slot_run qnap8528_slots_%d[] __initconst = {\n%s\t{ 0 }\n};\n\n", id, slots)
+	}
+	cfg_slots = slots_id[key]
+
+	configs = configs "\t{\n"
+	configs = configs sprintf("\t\t.name = \"%s\", .mb_model = \"%s\", .bp_model = \"%s\",\n", name, mb, bp)
+	if (features != "")
+		configs = configs sprintf("\t\t.features = {%s },\n", features)
+	configs = configs sprintf("\t\t.fans = qnap8528_fans_%d,\n", cfg_fans)
+	configs = configs sprintf("\t\t.slots = qnap8528_slots_%d,\n", cfg_slots)
+	if (timing != "")
+		configs = configs sprintf("\t\t.timing = QNAP8528_EC_TIMING_%s,\n", toupper(timing))
+	configs = configs "\t},\n"
+
+	name = mb = bp = timing = features = fans = slots = ""
+}
+
+BEGIN {
+	split("pwr_recovery eup_mode led_brightness led_status led_10g led_usb led_jbod led_ident enc_serial_mb", tmp, " ")
+	for (i in tmp)
+		valid_feature[tmp[i]] = 1
+	split("present active error locate power_ctrl", tmp, " ")
+	for (i in tmp)
+		valid_flag[tmp[i]] = 1
+	valid_timing["ene"] = 1
+
+	n = split(models, tmp, /[ \t,]+/)
+	for (i = 1; i <= n; i++) {
+		if (tmp[i] != "" && !(tmp[i] in wanted)) {
+			wanted[tmp[i]] = 1
+			nwanted++
+		}
+	}
+}
+
+/^[ \t]*(#|$)/ {
+	next
+}
+
+{
+	sep = index($0, ":")
+	if (!sep)
+		fail("expected 'key: value'")
+
+	key = substr($0, 1, sep - 1)
+	val = substr($0, sep + 1)
+	sub(/^[ \t]+/, "", val)
+	sub(/[ \t]+$/, "", val)
+	n = split(val, f, /[ \t]+/)
+}
+
+key == "model" {
+	finish_model()
+	name = val
+	next
+}
+
+name == "" {
+	fail("'" key "' outside of a model")
+}
+
+key == "mb" {
+	mb = val
+	next
+}
+
+key == "bp" {
+	bp = val
+	next
+}
+
+key == "timing" {
+	if (!(val in valid_timing))
+		fail("unknown timing profile '" val "'")
+	timing = val
+	next
+}
+
+key == "features" {
+	for (i = 1; i <= n; i++) {
+		if (!(f[i] in valid_feature))
+			fail("unknown feature '" f[i] "'")
+		features = features sprintf(" .%s = 1,", f[i])
+	}
+	next
+}
+
+key == "fans" {
+	for (i = 1; i <= n; i++) {
+		if (f[i] !~ /^[0-9]+$/ || f[i] == 0)
+			fail("bad fan index '" f[i] "'")
+		fans = fans f[i] ", "
+	}
+	next
+}
+
+key == "slots" {
+	if (n < 4 || f[2] !~ /^[0-9]+$/ || f[3] !~ /^[0-9]+$/ || f[4] !~ /^[0-9]+$/ || f[3] == 0)
+		fail("expected 'slots: <prefix> <first> <count> <ec index> [flags]'")
+
+	line = sprintf("\t{ .prefix = \"%s\", .first = %d, .count = %d, .ec_index = %d",
+		       f[1] == "-" ? "" : f[1], f[2], f[3], f[4])
+	for (i = 5; i <= n; i++) {
+		if (!(f[i] in valid_flag))
+			fail("unknown slot flag '" f[i] "'")
+		line = line sprintf(", .has_%s = 1", f[i])
+	}
+	slots = slots line " },\n"
+	next
+}
+
+{
+	fail("unknown key '" key "'")
+}
+
+END {
+	if (err)
+		exit 1
+
+	finish_model()
+
+	for (key in wanted) {
+		if (!(key in found)) {
+			printf("%s: unknown model '%s' in models\n", FILENAME, key) > "/dev/stderr"
+			exit 1
+		}
+	}
+
+	print "/* Generated from qnap8528_models.txt by qnap8528_models.awk, do not edit */"
+	print ""
+	printf("%s", arrays)
+	print "static const struct qnap8528_config qnap8528_configs[] __initconst = {"
+	printf("%s", configs)
+	print "\t{ NULL }"
+	print "};"
+}
@@ -0,0 +1,132 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM qnap8528
+
+#if !defined(_QNAP8528_TRACE_H) || defined(TRACE_HEADER_MULTI_READ)
+#define _QNAP8528_TRACE_H
+
+#include <linux/tracepoint.h>
+
+/*
+ * Every EC request is tagged with a sequence number when it is submitted,
+ * qnap8528_ec_submit fires in the context of the caller (sysfs, hwmon, LED,
+ * input poller) while the rest fire on the EC worker, matching @seq ties
+ * the EC traffic back to whoever caused it.
+ */
+TRACE_EVENT(qnap8528_ec_submit,
+	TP_PROTO(u32 seq, u16 command, int count, int class, bool async),
+	TP_ARGS(seq, command, count, class, async),
+	TP_STRUCT__entry(
+		__field(u32, seq)
+		__field(u16, command)
+		__field(int, count)
+		__field(int, class)
+		__field(bool, async)
+	),
+	TP_fast_assign(
+		__entry->seq = seq;
+		__entry->command = command;
+		__entry->count = count;
+		__entry->class = class;
+		__entry->async = async;
+	),
+	TP_printk("seq=%u command=0x%04x count=%d class=%s async=%d",
+		  __entry->seq, __entry->command, __entry->count,
+		  __print_symbolic(__entry->class, { 0, "interactive" }, { 1, "periodic" }, { 2, "bulk" }),
+		  __entry->async)
+);
+
+/*
+ * Transport events share one layout: the register, the data byte (0 until a
+ * read has it), the status polls retried and the time since the access began.
+ */
+DECLARE_EVENT_CLASS(qnap8528_ec_xact,
+	TP_PROTO(u32 seq, u16 command, u8 data, u32 retries, s64 elapsed_ns, int ret),
+	TP_ARGS(seq, command, data, retries, elapsed_ns, ret),
+	TP_STRUCT__entry(
+		__field(u32, seq)
+		__field(u16, command)
+		__field(u8, data)
+		__field(u32, retries)
+		__field(s64, elapsed_ns)
+		__field(int, ret)
+	),
+	TP_fast_assign(
+		__entry->seq = seq;
+		__entry->command = command;
+		__entry->data = data;
+		__entry->retries = retries;
+		__entry->elapsed_ns = elapsed_ns;
+		__entry->ret = ret;
+	),
+	TP_printk("seq=%u command=0x%04x data=0x%02x retries=%u elapsed_ns=%lld ret=%d",
+		  __entry->seq, __entry->command, __entry->data, __entry->retries,
+		  __entry->elapsed_ns, __entry->ret)
+);
+
+DEFINE_EVENT(qnap8528_ec_xact, qnap8528_ec_send_command,
+	TP_PROTO(u32 seq, u16 command, u8 data, u32 retries, s64 elapsed_ns, int ret),
+	TP_ARGS(seq, command, data, retries, elapsed_ns, ret)
+);
+
+DEFINE_EVENT(qnap8528_ec_xact, qnap8528_ec_read,
+	TP_PROTO(u32 seq, u16 command, u8 data, u32 retries, s64 elapsed_ns, int ret),
+	TP_ARGS(seq, command, data, retries, elapsed_ns, ret)
+);
+
+DEFINE_EVENT(qnap8528_ec_xact, qnap8528_ec_write,
+	TP_PROTO(u32 seq, u16 command, u8 data, u32 retries, s64 elapsed_ns, int ret),
+	TP_ARGS(seq, command, data, retries, elapsed_ns, ret)
+);
+
+TRACE_EVENT(qnap8528_ec_timeout,
+	TP_PROTO(u32 seq, u16 command, u8 data, int stage, u32 retries, s64 elapsed_ns),
+	TP_ARGS(seq, command, data, stage, retries, elapsed_ns),
+	TP_STRUCT__entry(
+		__field(u32, seq)
+		__field(u16, command)
+		__field(u8, data)
+		__field(int, stage)
+		__field(u32, retries)
+		__field(s64, elapsed_ns)
+	),
+	TP_fast_assign(
+		__entry->seq = seq;
+		__entry->command = command;
+		__entry->data = data;
+		__entry->stage = stage;
+		__entry->retries = retries;
+		__entry->elapsed_ns = elapsed_ns;
+	),
+	TP_printk("seq=%u command=0x%04x data=0x%02x stage=%s retries=%u elapsed_ns=%lld",
+		  __entry->seq, __entry->command, __entry->data,
+		  __print_symbolic(__entry->stage, { 0, "ibf_clear" }, { 1, "obf_clear" }, { 2, "obf_set" }),
+		  __entry->retries, __entry->elapsed_ns)
+);
+
+TRACE_EVENT(qnap8528_ec_complete,
+	TP_PROTO(u32 seq, int status, s64 wait_ns, s64 hold_ns),
+	TP_ARGS(seq, status, wait_ns, hold_ns),
+	TP_STRUCT__entry(
+		__field(u32, seq)
+		__field(int, status)
+		__field(s64, wait_ns)
+		__field(s64, hold_ns)
+	),
+	TP_fast_assign(
+		__entry->seq = seq;
+		__entry->status = status;
+		__entry->wait_ns = wait_ns;
+		__entry->hold_ns = hold_ns;
+	),
+	TP_printk("seq=%u status=%d wait_ns=%lld hold_ns=%lld",
+		  __entry->seq, __entry->status, __entry->wait_ns, __entry->hold_ns)
+);
+
+#endif /* _QNAP8528_TRACE_H */
+
+#undef TRACE_INCLUDE_PATH
+#define TRACE_INCLUDE_PATH .
+#undef TRACE_INCLUDE_FILE
+#define TRACE_INCLUDE_FILE qnap8528_trace
+#include <trace/define_trace.h>